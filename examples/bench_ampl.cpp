@@ -0,0 +1,382 @@
+//============================================================================
+//                                  I B E X
+// File        : bench_ampl
+// Author      : Jordan Ninin
+// License     : See the LICENSE file
+// Created     : Oct 2, 2026
+// Last Update : Oct 17, 2026
+//============================================================================
+
+// Benchmark of the AMPL interface: loading, size of the resulting
+// expressions, cost of an evaluation and of an HC4 contraction per box.
+//
+// Usage: bench_ampl <file.nl> [nb_boxes] [simpl_level]
+//        bench_ampl --sum <n> [nb_boxes] [simpl_level]
+//        bench_ampl --defvars <n> [nb_boxes] [simpl_level]
+//        bench_ampl --defrefs <n> <m> [nb_boxes] [simpl_level]
+//        bench_ampl --ranges <n> [nb_boxes] [simpl_level]
+//        bench_ampl --decode <n>
+//        bench_ampl --scaling <n>
+//
+// With --sum, the model  sum_{i<n} x[i]^2 + sum_{i<n} (i+1)*x[i] <= n
+// is generated in "bench_sum.nl" and used as input.
+//
+// With --defvars, a model with n nested defined variables
+//   d[0] = x[0]+x[1],  d[j] = sin(d[j-1])*d[j-1] + x[j%10],  d[n-1] <= 1
+// is generated in "bench_defvars.nl" (compare with ibexopt_options="aux_vars=1").
+//
+// With --defrefs, a model with n defined variables d[j] = x[j%10]*x[(j+1)%10]
+// and the constraint  sum_{i<m} d[i%n] <= 1  (m references to the defined
+// variables) is generated in "bench_defrefs.nl".
+//
+// With --ranges, a model with n variables and the n range constraints
+//   -0.5 <= x[i]*x[i+1] + x[i+1]^2 <= 0.5
+// is generated in "bench_ranges.nl" (each one translated into two inequalities).
+//
+// With --decode, only the decoding of the operator of n random AMPL
+// nodes is measured (cost per node of AmplInterface::opcode).
+//
+// With --scaling, the loading times of the --sum models with n and 10n terms
+// are compared: the translation must be linear in the number of terms (the
+// exit status is 1 if the ratio exceeds 30).
+//
+// The options of the interface are read in the environment variable
+// "ibexopt_options", e.g., ibexopt_options="nl_reader=1" to load the
+// file with the native reader.
+
+#include "ibex.h"
+#include "ibex_AmplInterface.h"
+
+#include "asl.h"
+#include "nlp.h"
+#include "r_opn.hd" /* for N_OPS */
+
+#include <ctime>
+#include <cstdlib>
+#include <new>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+using namespace std;
+using namespace ibex;
+
+// number of heap allocations (operator new) since the start
+static long nb_allocs = 0;
+
+void* operator new(size_t n) {
+	nb_allocs++;
+	void* p = malloc(n ? n : 1);
+	if (!p) throw bad_alloc();
+	return p;
+}
+
+void operator delete(void* p) noexcept {
+	free(p);
+}
+
+namespace {
+
+double cpu_time() {
+	return ((double) clock()) / CLOCKS_PER_SEC;
+}
+
+double wall_time() {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec*1e-6;
+}
+
+// peak resident memory of the process (in MB)
+double peak_memory() {
+	struct rusage r;
+	getrusage(RUSAGE_SELF, &r);
+	return r.ru_maxrss / 1024.0; // in kB on Linux
+}
+
+void write_sum_nl(const char* nlfile, int n) {
+	ofstream f(nlfile);
+	f << "g3 1 1 0\t# problem bench_sum\n";
+	f << " " << n << " 1 0 0 0\t# vars, constraints, objectives, ranges, eqns\n";
+	f << " 1 0\t# nonlinear constraints, objectives\n";
+	f << " 0 0\t# network constraints: nonlinear, linear\n";
+	f << " " << n << " 0 0\t# nonlinear vars in constraints, objectives, both\n";
+	f << " 0 0 0 1\t# linear network variables; functions; arith, flags\n";
+	f << " 0 0 0 0 0\t# discrete variables: binary, integer, nonlinear (b,c,o)\n";
+	f << " " << n << " 0\t# nonzeros in Jacobian, gradients\n";
+	f << " 0 0\t# max name lengths: constraints, variables\n";
+	f << " 0 0 0 0 0\t# common exprs: b,c,o,c1,o1\n";
+	f << "C0\no54\n" << n << "\n";
+	for (int i=0; i<n; i++)
+		f << "o5\nv" << i << "\nn2\n";
+	f << "r\n1 " << n << "\n";
+	f << "b\n";
+	for (int j=0; j<n; j++)
+		f << "0 -1 1\n";
+	f << "k" << n-1 << "\n";
+	for (int j=1; j<n; j++)
+		f << j << "\n";
+	f << "J0 " << n << "\n";
+	for (int j=0; j<n; j++)
+		f << j << " " << j+1 << "\n";
+}
+
+void write_defvars_nl(const char* nlfile, int n) {
+	ofstream f(nlfile);
+	f << "g3 1 1 0\t# problem bench_defvars\n";
+	f << " 10 1 0 0 0\t# vars, constraints, objectives, ranges, eqns\n";
+	f << " 1 0\t# nonlinear constraints, objectives\n";
+	f << " 0 0\t# network constraints: nonlinear, linear\n";
+	f << " 10 0 0\t# nonlinear vars in constraints, objectives, both\n";
+	f << " 0 0 0 1\t# linear network variables; functions; arith, flags\n";
+	f << " 0 0 0 0 0\t# discrete variables: binary, integer, nonlinear (b,c,o)\n";
+	f << " 10 0\t# nonzeros in Jacobian, gradients\n";
+	f << " 0 0\t# max name lengths: constraints, variables\n";
+	f << " 0 " << n << " 0 0 0\t# common exprs: b,c,o,c1,o1\n";
+	f << "V10 2 0\n0 1\n1 1\nn0\n";
+	for (int j=1; j<n; j++)
+		f << "V" << 10+j << " 1 0\n" << j%10 << " 1\no2\no41\nv" << 9+j << "\nv" << 9+j << "\n";
+	f << "C0\nv" << 9+n << "\n";
+	f << "r\n1 1\n";
+	f << "b\n";
+	for (int j=0; j<10; j++)
+		f << "0 -1 1\n";
+	f << "k9\n";
+	for (int j=1; j<10; j++)
+		f << j << "\n";
+	f << "J0 10\n";
+	for (int j=0; j<10; j++)
+		f << j << " 0\n";
+}
+
+void write_defrefs_nl(const char* nlfile, int n, int m) {
+	ofstream f(nlfile);
+	f << "g3 1 1 0\t# problem bench_defrefs\n";
+	f << " 10 1 0 0 0\t# vars, constraints, objectives, ranges, eqns\n";
+	f << " 1 0\t# nonlinear constraints, objectives\n";
+	f << " 0 0\t# network constraints: nonlinear, linear\n";
+	f << " 10 0 0\t# nonlinear vars in constraints, objectives, both\n";
+	f << " 0 0 0 1\t# linear network variables; functions; arith, flags\n";
+	f << " 0 0 0 0 0\t# discrete variables: binary, integer, nonlinear (b,c,o)\n";
+	f << " 10 0\t# nonzeros in Jacobian, gradients\n";
+	f << " 0 0\t# max name lengths: constraints, variables\n";
+	f << " 0 " << n << " 0 0 0\t# common exprs: b,c,o,c1,o1\n";
+	for (int j=0; j<n; j++)
+		f << "V" << 10+j << " 0 0\no2\nv" << j%10 << "\nv" << (j+1)%10 << "\n";
+	f << "C0\no54\n" << m << "\n";
+	for (int i=0; i<m; i++)
+		f << "v" << 10+i%n << "\n";
+	f << "r\n1 1\n";
+	f << "b\n";
+	for (int j=0; j<10; j++)
+		f << "0 -1 1\n";
+	f << "k9\n";
+	for (int j=1; j<10; j++)
+		f << j << "\n";
+	f << "J0 10\n";
+	for (int j=0; j<10; j++)
+		f << j << " 0\n";
+}
+
+void write_ranges_nl(const char* nlfile, int n) {
+	ofstream f(nlfile);
+	f << "g3 1 1 0\t# problem bench_ranges\n";
+	f << " " << n << " " << n << " 0 " << n << " 0\t# vars, constraints, objectives, ranges, eqns\n";
+	f << " " << n << " 0\t# nonlinear constraints, objectives\n";
+	f << " 0 0\t# network constraints: nonlinear, linear\n";
+	f << " " << n << " 0 0\t# nonlinear vars in constraints, objectives, both\n";
+	f << " 0 0 0 1\t# linear network variables; functions; arith, flags\n";
+	f << " 0 0 0 0 0\t# discrete variables: binary, integer, nonlinear (b,c,o)\n";
+	f << " " << 2*n << " 0\t# nonzeros in Jacobian, gradients\n";
+	f << " 0 0\t# max name lengths: constraints, variables\n";
+	f << " 0 0 0 0 0\t# common exprs: b,c,o,c1,o1\n";
+	for (int i=0; i<n; i++)
+		f << "C" << i << "\no0\no2\nv" << i << "\nv" << (i+1)%n << "\no5\nv" << (i+1)%n << "\nn2\n";
+	f << "r\n";
+	for (int i=0; i<n; i++)
+		f << "0 -0.5 0.5\n";
+	f << "b\n";
+	for (int j=0; j<n; j++)
+		f << "0 -1 1\n";
+	f << "k" << n-1 << "\n";
+	for (int j=1; j<n; j++)
+		f << 2*j << "\n";
+	for (int i=0; i<n; i++) {
+		int j = (i+1)%n;
+		f << "J" << i << " 2\n";
+		f << (i<j ? i : j) << " 0\n" << (i<j ? j : i) << " 0\n";
+	}
+}
+
+// CPU time (in seconds) for loading a .nl file
+double load_time(const char* nlfile) {
+	double t = cpu_time();
+	{
+		AmplInterface ampl(nlfile);
+	}
+	return cpu_time() - t;
+}
+
+// Cost (in seconds) of the decoding of the operator of one AMPL node
+double decode_time(int n) {
+	vector<expr> nodes(1000);
+	srand(1);
+	for (size_t i=0; i<nodes.size(); i++)
+		nodes[i].op = r_ops[rand() % N_OPS];
+
+	long sum = 0;
+	double t = cpu_time();
+	for (int k=0; k<n; k++)
+		sum += AmplInterface::opcode(&nodes[k % nodes.size()]);
+	t = cpu_time() - t;
+
+	// to prevent the loop from being optimized out
+	if (sum<0) cout << sum << endl;
+	return t / n;
+}
+
+}
+
+int main(int argc, char** argv) {
+
+	if (argc<2) {
+		cerr << "usage: bench_ampl <file.nl> [nb_boxes] [simpl_level]" << endl;
+		cerr << "       bench_ampl --sum <n> [nb_boxes] [simpl_level]" << endl;
+		cerr << "       bench_ampl --defvars <n> [nb_boxes] [simpl_level]" << endl;
+		cerr << "       bench_ampl --defrefs <n> <m> [nb_boxes] [simpl_level]" << endl;
+		cerr << "       bench_ampl --ranges <n> [nb_boxes] [simpl_level]" << endl;
+		cerr << "       bench_ampl --decode <n>" << endl;
+		cerr << "       bench_ampl --scaling <n>" << endl;
+		return 1;
+	}
+
+	if (strcmp(argv[1],"--scaling")==0) {
+		int n = argc>2 ? atoi(argv[2]) : 100000;
+		write_sum_nl("bench_sum1.nl", n);
+		write_sum_nl("bench_sum2.nl", 10*n);
+		double t1 = load_time("bench_sum1.nl");
+		double t2 = load_time("bench_sum2.nl");
+		cout << "loading time (" << n << " terms):    " << t1 << "s" << endl;
+		cout << "loading time (" << 10*n << " terms):   " << t2 << "s" << endl;
+		cout << "ratio:                " << (t1>0 ? t2/t1 : 0) << " (linear: ~10)" << endl;
+		remove("bench_sum1.nl");
+		remove("bench_sum2.nl");
+		return t2 < 30*t1 + 1.0 ? 0 : 1;
+	}
+
+	if (strcmp(argv[1],"--decode")==0) {
+		int n = argc>2 ? atoi(argv[2]) : 10000000;
+		cout << "decoding / node:      " << decode_time(n)*1e9 << "ns" << endl;
+		return 0;
+	}
+
+	const char* nlfile = argv[1];
+	int arg = 2;
+	if (strcmp(argv[1],"--sum")==0) {
+		if (argc<3) {
+			cerr << "--sum: missing number of terms" << endl;
+			return 1;
+		}
+		nlfile = "bench_sum.nl";
+		write_sum_nl(nlfile, atoi(argv[2]));
+		arg = 3;
+	} else if (strcmp(argv[1],"--defvars")==0) {
+		if (argc<3) {
+			cerr << "--defvars: missing number of defined variables" << endl;
+			return 1;
+		}
+		nlfile = "bench_defvars.nl";
+		write_defvars_nl(nlfile, atoi(argv[2]));
+		arg = 3;
+	} else if (strcmp(argv[1],"--defrefs")==0) {
+		if (argc<4) {
+			cerr << "--defrefs: missing number of defined variables or of references" << endl;
+			return 1;
+		}
+		nlfile = "bench_defrefs.nl";
+		write_defrefs_nl(nlfile, atoi(argv[2]), atoi(argv[3]));
+		arg = 4;
+	} else if (strcmp(argv[1],"--ranges")==0) {
+		if (argc<3) {
+			cerr << "--ranges: missing number of constraints" << endl;
+			return 1;
+		}
+		nlfile = "bench_ranges.nl";
+		write_ranges_nl(nlfile, atoi(argv[2]));
+		arg = 3;
+	}
+	int nb_boxes = argc>arg ? atoi(argv[arg]) : 1000;
+	int simpl = argc>arg+1 ? atoi(argv[arg+1]) : ExprNode::default_simpl_level;
+
+	double t = cpu_time();
+	double w = wall_time();
+	long allocs = nb_allocs;
+	AmplInterface ampl(nlfile);
+	ampl.set_simplification_level(simpl);
+	double t_load = cpu_time() - t;
+	double w_load = wall_time() - w;
+	double mem_load = peak_memory();
+	allocs = nb_allocs - allocs;
+
+	t = cpu_time();
+	System sys(ampl);
+	double t_build = cpu_time() - t;
+
+	int max_height = 0;
+	long size = 0;
+	for (int i=0; i<sys.nb_ctr; i++) {
+		const ExprNode& e = sys.ctrs[i].f.expr();
+		if (e.height > max_height) max_height = e.height;
+		size += e.size;
+	}
+
+	cout << "file:                 " << nlfile << endl;
+	cout << "variables:            " << sys.nb_var << endl;
+	cout << "constraints:          " << sys.nb_ctr << endl;
+	cout << "simplification level: " << simpl << endl;
+	cout << "expression nodes:     " << size << endl;
+	cout << "max height:           " << max_height << endl;
+	cout << "shared nodes:         " << 100*ampl.get_sharing_ratio() << "%" << endl;
+	cout << "folded operations:    " << ampl.get_nb_folded() << endl;
+	cout << "reader:               " << (ampl.get_nl_reader()==1 ? "native" : "ASL") << endl;
+	cout << "loading time:         " << t_load << "s (wall: " << w_load << "s)" << endl;
+	cout << "peak memory (load):   " << mem_load << "MB" << endl;
+	cout << "heap allocations:     " << allocs << " (load)" << endl;
+	cout << "building time:        " << t_build << "s" << endl;
+
+	if (sys.nb_ctr==0) return 0;
+
+	// random sub-boxes of the initial box
+	IntervalVector init(sys.box);
+	init &= IntervalVector(sys.nb_var, Interval(-1e3,1e3));
+	srand(1);
+	vector<IntervalVector> boxes;
+	for (int k=0; k<nb_boxes; k++) {
+		IntervalVector b(sys.nb_var);
+		for (int i=0; i<sys.nb_var; i++) {
+			double a = init[i].lb() + init[i].diam()*(((double) rand())/RAND_MAX);
+			double c = init[i].lb() + init[i].diam()*(((double) rand())/RAND_MAX);
+			b[i] = a<c ? Interval(a,c) : Interval(c,a);
+		}
+		boxes.push_back(b);
+	}
+
+	t = cpu_time();
+	for (int k=0; k<nb_boxes; k++)
+		sys.f_ctrs.eval_vector(boxes[k]);
+	double t_eval = (cpu_time() - t) / nb_boxes;
+
+	CtcHC4 hc4(sys);
+	t = cpu_time();
+	for (int k=0; k<nb_boxes; k++)
+		hc4.contract(boxes[k]);
+	double t_hc4 = (cpu_time() - t) / nb_boxes;
+
+	cout << "evaluation / box:     " << t_eval*1e6 << "us" << endl;
+	cout << "HC4 contraction / box:" << t_hc4*1e6 << "us" << endl;
+	cout << "HC4 throughput:       " << (t_hc4>0 ? 1/t_hc4 : 0) << " boxes/s" << endl;
+
+	return 0;
+}
@@ -14,12 +14,191 @@
 #include "ibex.h"
 #include "parse_args.h"
 #include "ibex_AmplInterface.h"
+#include "ibex_AmplOptimizerConfig.h"
 
 #include <sstream>
+#include <memory>
 
 using namespace std;
 using namespace ibex;
 
+namespace {
+
+// rank of a status when the results of several subproblems are combined
+int status_rank(Optimizer::Status s) {
+	switch (s) {
+	case Optimizer::SUCCESS:           return 0;
+	case Optimizer::UNREACHED_PREC:    return 1;
+	case Optimizer::TIME_OUT:          return 2;
+	case Optimizer::UNBOUNDED_OBJ:     return 3;
+	case Optimizer::NO_FEASIBLE_FOUND: return 4;
+	default:                           return 5; // INFEASIBLE
+	}
+}
+
+const char* status_name(Optimizer::Status s) {
+	const char* names[] = { "success", "unreached precision", "time out", "unbounded objective", "no feasible point found", "infeasible" };
+	return names[status_rank(s)];
+}
+
+// The status of a search started from the upper bound of a warm start
+// (see AmplOptimizerConfig::warm_start()) that finds no better point:
+// there is none (up to the precision) if the search is complete.
+Optimizer::Status warm_status(Optimizer::Status s) {
+	switch (s) {
+	case Optimizer::INFEASIBLE:        return Optimizer::SUCCESS;
+	case Optimizer::NO_FEASIBLE_FOUND: return Optimizer::UNREACHED_PREC;
+	default:                           return s;
+	}
+}
+
+// Solves the independent subproblems of an AMPL model one after the other
+// (see AmplInterface::set_decompose()): the objective is the sum of their
+// objectives and the best point is made of their best points, written in
+// the .sol file (there is no COV output). Each subproblem gets the options
+// of config and its own AmplOptimizerConfig (blocks, start point and warm
+// start of its variables), the timeout being the time left by the previous
+// ones. Returns false if the system cannot be split.
+bool optimize_components(AmplInterface& ampl, const System& sys, DefaultOptimizerConfig& config) {
+	int nb = ampl.get_nb_components();
+	vector<System*> subsys;
+	for (int k=0; k<nb; k++) {
+		System* s = ampl.get_component_system(sys, k);
+		if (!s) break;
+		subsys.push_back(s);
+	}
+	if ((int) subsys.size()<nb) {
+		for (size_t k=0; k<subsys.size(); k++)
+			delete subsys[k];
+		return false;
+	}
+
+	const Vector& eps_x = config.get_eps_x();
+	double timeout = config.get_timeout();
+
+	// The gaps of the subproblems add up, whatever the signs of their
+	// objectives: each one gets the absolute precision eps_f/nb, where eps_f
+	// meets the precision required on the whole objective, |f*| being
+	// bounded below by the mignitude of the objective on the initial box.
+	double eps_f = std::max(config.get_abs_eps_f(), config.get_rel_eps_f()*sys.goal->eval(sys.box).mig());
+
+	// the result of the whole system
+	Optimizer::Status status = Optimizer::SUCCESS;
+	double uplo = 0, loup = 0, time = 0;
+	IntervalVector loup_point(sys.nb_var);
+
+	for (int k=0; k<nb; k++) {
+		vector<int> vars = ampl.get_component_vars(k);
+		Vector eps_k(vars.size());
+		for (size_t j=0; j<vars.size(); j++)
+			eps_k[j] = eps_x[vars[j]];
+
+		AmplOptimizerConfig config_k(*subsys[k], ampl, sys, k);
+		config_k.set_rel_eps_f(0);
+		config_k.set_abs_eps_f(eps_f/nb);
+		config_k.set_eps_h(config.get_eps_h());
+		config_k.set_eps_x(eps_k);
+		config_k.set_rigor(config.with_rigor());
+		config_k.set_kkt(config.with_kkt());
+		config_k.set_inHC4(config.with_inHC4());
+		config_k.set_random_seed(config.get_random_seed());
+		config_k.set_trace(config.get_trace());
+		// the time left (once spent, the next subproblems time out at once)
+		if (timeout>0)
+			config_k.set_timeout(std::max(timeout-time, 1e-3));
+
+		Optimizer o(config_k);
+
+		// warm start from the initial point of the subproblem
+		Vector x0(vars.size());
+		double loup0 = POS_INFINITY;
+		bool warm = config_k.warm_start(x0, loup0);
+
+		o.optimize(subsys[k]->box, loup0);
+
+		Optimizer::Status s = o.get_status();
+		double loup_k = o.get_loup();
+		IntervalVector p = loup_k < POS_INFINITY ? o.get_loup_point() : subsys[k]->box;
+		if (warm && !(loup_k < loup0)) {
+			s = warm_status(s);
+			loup_k = loup0;
+			p = IntervalVector(x0);
+			if (s != o.get_status())
+				cout << " component " << k << ": status " << status_name(o.get_status()) << " overridden by "
+				     << status_name(s) << " (no better point than the warm start)" << endl;
+		}
+
+		if (status_rank(s) > status_rank(status)) status = s;
+		uplo += o.get_uplo();
+		loup += loup_k;
+		time += o.get_time();
+		for (size_t j=0; j<vars.size(); j++)
+			loup_point[vars[j]] = p[j];
+
+		cout << " component " << k << ":\t" << subsys[k]->nb_var << " var(s), " << subsys[k]->nb_ctr << " ctr(s)\t"
+		     << status_name(s) << "\t[" << o.get_uplo() << ", " << loup_k << "]\t"
+		     << o.get_time() << "s" << (warm ? "\t(warm start)" : "") << endl;
+	}
+
+	cout << endl << " " << nb << " subproblems: " << status_name(status) << endl;
+	cout << " f* in\t[" << uplo << "," << loup << "]" << endl;
+	cout << " cpu time used:\t\t\t" << time << "s" << endl;
+
+	ampl.writeSolution(status, loup_point, timeout);
+
+	for (int k=0; k<nb; k++)
+		delete subsys[k];
+	return true;
+}
+
+// Solves an AMPL model without objective: the box is paved by a solver or,
+// with first_sol, the search stops at the first certified solution (see
+// AmplInterface::set_first_sol()). The solver certifies the solutions of
+// the equalities themselves (by interval Newton): eps_h and rigor, which
+// relax or certify the equalities of an optimizer, are not used.
+void solve_csp(AmplInterface& ampl, const System& sys, const string& file, double timeout, double eps_x,
+		double random_seed, int trace, bool quiet, bool option_ampl) {
+
+	bool first = ampl.get_first_sol()==1;
+
+	// (depth-first search for the first solution)
+	DefaultSolver s(sys, eps_x, DefaultSolver::default_eps_x_max, first, random_seed);
+	s.time_limit = timeout;
+	s.trace = trace;
+
+	if (!quiet) {
+		cout << endl << "************************ setup ************************" << endl;
+		cout << "  file loaded:\t\t" << file << endl;
+		cout << "  no objective:\t\tsolved as a constraint satisfaction problem"
+				<< (first ? " (first solution)" : "") << endl;
+		cout << "  eps_x:\t\t" << eps_x << "\t(precision on variables domain)" << endl;
+		cout << "  equalities:\t\tsolutions certified (eps_h and rigor unused)" << endl;
+		if (timeout>0)
+			cout << "  timeout:\t\t" << timeout << "s" << endl;
+		cout << "*******************************************************" << endl << endl;
+		cout << "running............" << endl << endl;
+	}
+
+	Solver::Status status;
+	if (first) {
+		s.start(sys.box);
+		CovSolverData::BoxStatus box_status;
+		bool found = false;
+		while (!found && s.next(box_status))
+			found = (box_status==CovSolverData::SOLUTION);
+		status = found ? Solver::SUCCESS : s.get_status();
+	} else
+		status = s.solve(sys.box);
+
+	if (!quiet || option_ampl)
+		s.report();
+
+	if (option_ampl)
+		ampl.writeSolution(s, status);
+}
+
+}
+
 int main(int argc, char** argv) {
 
 #ifdef __IBEX_NO_LP_SOLVER__
@@ -142,7 +321,23 @@ int main(int argc, char** argv) {
 			sys = new System(filename.Get().c_str(), simpl_level? simpl_level.Get() : ExprNode::default_simpl_level);
 		}
 		
-		DefaultOptimizerConfig config(*sys);
+		// A model without objective is solved by a solver
+		if (!sys->goal && (extension == "nl" || option_ampl)) {
+			cout.precision(12);
+			solve_csp(*ampl, *sys, filename.Get(),
+					timeout ? timeout.Get() : ampl->get_timeout(),
+					eps_x_arg ? eps_x_arg.Get() : DefaultSolver::default_eps_x_min,
+					random_seed ? random_seed.Get() : ampl->get_random_seed(),
+					trace ? 1 : ampl->get_trace(), quiet, option_ampl);
+			if (option_ampl) delete ampl;
+			delete sys;
+			return 0;
+		}
+
+		// (the configuration of an AMPL model uses its structure)
+		unique_ptr<DefaultOptimizerConfig> _config(extension == "nl" || option_ampl ?
+				new AmplOptimizerConfig(*sys, *ampl) : new DefaultOptimizerConfig(*sys));
+		DefaultOptimizerConfig& config = *_config;
 
 		if (extension == "nl" || option_ampl) {
 
@@ -179,6 +374,24 @@ int main(int argc, char** argv) {
 		if (!quiet) {
 			cout << endl << "************************ setup ************************" << endl;
 			cout << "  file loaded:\t\t" << filename.Get() << endl;
+			if ((extension == "nl" || option_ampl) && ampl->get_presolve()==1) {
+				cout << "  presolve:\t\t" << ampl->get_nb_fixed() << " fixed variable(s) removed, "
+						<< ampl->get_nb_bound_rows() << " constraint(s) put in the bounds, "
+						<< ampl->get_nb_redundant_rows() << " redundant constraint(s) removed, "
+						<< ampl->get_nb_duplicate_rows() << " duplicate constraint(s) removed, "
+						<< ampl->get_nb_tightened() << " bound(s) tightened" << endl;
+			}
+			if ((extension == "nl" || option_ampl) && ampl->get_nb_blocks()>0) {
+				cout << "  blocks:\t\t" << ampl->get_nb_blocks() << " block(s) of equations contracted by interval Newton" << endl;
+			}
+			if ((extension == "nl" || option_ampl) && ampl->get_nb_components()>1) {
+				cout << "  decomposition:\t" << ampl->get_nb_components() << " independent subproblems (solved separately with -AMPL)" << endl;
+			}
+			Vector x_start(sys->nb_var);
+			if ((extension == "nl" || option_ampl) && ampl->get_start_priority()>0 && ampl->get_start_point(x_start)) {
+				cout << "  start priority:\t" << "boxes containing the start point explored first ("
+						<< ampl->get_start_priority() << " node(s))" << endl;
+			}
 		}
 
 		if (rel_eps_f) {
@@ -336,9 +549,39 @@ int main(int argc, char** argv) {
 		}
 
 
+		// Solve the independent subproblems separately, with -AMPL only: the
+		// COV output and the initial loup are for the whole system (each
+		// subproblem can be warm started from its own initial point instead)
+		if ((extension == "nl" || option_ampl) && ampl->get_nb_components()>1 && !input_file) {
+			cout.precision(12);
+			if (!option_ampl || initial_loup1 < POS_INFINITY) {
+				if (!quiet || option_ampl)
+					cout << "decomposition ignored (COV output or initial loup of the whole system)" << endl;
+			} else if (optimize_components(*ampl, *sys, config)) {
+				delete ampl;
+				delete sys;
+				return 0;
+			}
+		}
+
 		// Build the default optimizer
 		Optimizer o(config);
 
+		// Warm start from the initial point of the AMPL model (only with
+		// -AMPL, see AmplInterface::set_warm_start())
+		Vector x0(sys->nb_var);
+		double loup0 = POS_INFINITY;
+		bool warm = false;
+		if (option_ampl && !input_file
+				&& static_cast<AmplOptimizerConfig&>(config).warm_start(x0, loup0)
+				&& loup0 < initial_loup1) {
+			warm = true;
+			initial_loup1 = loup0;
+			if (!quiet)
+				cout << "warm start: f(x0) <= " << loup0 << endl;
+		} else if (extension == "nl" && !option_ampl && ampl->get_warm_start()==1 && !quiet)
+			cout << "warm start ignored (no COV output of the initial point, use -AMPL)" << endl;
+
 		// display solutions with up to 12 decimals
 		cout.precision(12);
 
@@ -372,7 +615,15 @@ int main(int argc, char** argv) {
 			//  si l'option -AMPL est présent, ecrire le fichier .sol pour ampl
 
 			o.report();
-			ampl->writeSolution(o);
+			if (warm && !(o.get_loup() < loup0)) {
+				// no better point than the warm start
+				cout << " (the best point is the warm start)" << endl;
+				if (warm_status(o.get_status()) != o.get_status())
+					cout << " (status " << status_name(o.get_status()) << " overridden by "
+					     << status_name(warm_status(o.get_status())) << ")" << endl;
+				ampl->writeSolution(warm_status(o.get_status()), IntervalVector(x0), o.timeout);
+			} else
+				ampl->writeSolution(o);
 
 			if (ampl) {
 				delete ampl;
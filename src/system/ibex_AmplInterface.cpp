@@ -10,6 +10,7 @@
 //============================================================================
 
 #include "ibex_AmplInterface.h"
+#include "ibex_NlReader.h"
 #include "ibex.h"
 //#include "ibex/ibex_Exception.h"
 //#include "ibex/ibex_ExtendedSystem.h"
@@ -25,7 +26,12 @@
 //#include <math.h>
 
 #include <stdint.h>
+#include <cstring>
 #include <sstream>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <set>
 
 
 #ifndef Intcast
@@ -44,26 +50,56 @@
 // The options of IbexOpt available in AMPL
 static double ibex_rel_eps_f=-12345, ibex_abs_eps_f=-12345, ibex_initial_loup=-12345, ibex_timeout=-12345, ibex_eps_h=-12345;
 static int ibex_trace2=-12345, ibex_random_seed=-12345, ibex_objno=-12345, ibex_simpl_level=-12345;
-static int	ibex_rigor=-12345, ibex_kkt=-12345, ibex_inHC4=-12345;
+static double ibex_simpl_budget=-12345;
+static int	ibex_rigor=-12345, ibex_kkt=-12345, ibex_inHC4=-12345, ibex_presolve=-12345, ibex_decompose=-12345, ibex_blocks=-12345, ibex_first_sol=-12345;
+static int	ibex_warm_start=-12345, ibex_start_priority=-12345;
+static int	ibex_aux_vars=-12345, ibex_linear_form=-12345, ibex_nl_reader=-12345, ibex_nl_threads=-12345, ibex_lazy=-12345, ibex_streaming=-12345;
+
+// Reset the options before reading them (several models may be loaded by the same process)
+static void reset_keywords() {
+	ibex_rel_eps_f=ibex_abs_eps_f=ibex_initial_loup=ibex_timeout=ibex_eps_h=-12345;
+	ibex_trace2=ibex_random_seed=ibex_objno=ibex_simpl_level=-12345;
+	ibex_simpl_budget=-12345;
+	ibex_rigor=ibex_kkt=ibex_inHC4=ibex_presolve=ibex_decompose=ibex_blocks=ibex_first_sol=-12345;
+	ibex_warm_start=ibex_start_priority=-12345;
+	ibex_aux_vars=ibex_linear_form=ibex_nl_reader=ibex_nl_threads=ibex_lazy=ibex_streaming=-12345;
+}
 
 static
 keyword keywds[] = { // must be alphabetical order
 		KW(const_cast<char*>("abs_eps_f"), D_val, &ibex_abs_eps_f, const_cast<char*>("Absolute precision on the objective function. Default: 1.e-7. ")),
-		KW(const_cast<char*>("eps_h"), D_val, &ibex_eps_h, const_cast<char*>("Relaxation value of the equality constraints. Default: 1.e-8. ")),
+		KW(const_cast<char*>("aux_vars"), I_val, &ibex_aux_vars, const_cast<char*>("Turn each defined variable into an auxiliary variable with a defining equality (1) instead of inlining its expression (0). Default: 0. ")),
+		KW(const_cast<char*>("blocks"), I_val, &ibex_blocks, const_cast<char*>("Contract the square blocks of equations (block-triangular decomposition of the Jacobian) in order with interval Newton (1). Ignored in lazy mode and with aux_vars. Default: 0. ")),
+		KW(const_cast<char*>("decompose"), I_val, &ibex_decompose, const_cast<char*>("Split the model into independent subproblems (connected components of the variable-constraint graph) solved one after the other (1), by ibexopt with -AMPL and no initial loup (the COV file and the initial loup are for the whole system). Ignored in lazy mode and with aux_vars. Default: 0. ")),
+		KW(const_cast<char*>("eps_h"), D_val, &ibex_eps_h, const_cast<char*>("Relaxation value of the equality constraints (optimization only). Default: 1.e-8. ")),
+		KW(const_cast<char*>("first_sol"), I_val, &ibex_first_sol, const_cast<char*>("For a model without objective: stop the search at the first certified solution (1) instead of paving the whole box (0). Default: 0. ")),
 		KW(const_cast<char*>("inHC4"), I_val, &ibex_inHC4, const_cast<char*>("If true, feasibility is also tried with LoupFinderInHC4. Default: 1. ")),
 		KW(const_cast<char*>("init_obj_value"), D_val, &ibex_initial_loup, const_cast<char*>("Initialization of the upper bound with a known value. Default: +infinity. ")),
 		KW(const_cast<char*>("kkt"), I_val, &ibex_kkt, const_cast<char*>("Activate KKT contractor. Default: 0. ")),
+		KW(const_cast<char*>("lazy"), I_val, &ibex_lazy, const_cast<char*>("Translate the constraints only on demand (1) instead of when the file is loaded (0). Default: 0. ")),
+		KW(const_cast<char*>("linear_form"), I_val, &ibex_linear_form, const_cast<char*>("Translate the linear part of each constraint and objective into a single sparse dot product (1) instead of a sum of products (0). Default: 0. ")),
+		KW(const_cast<char*>("nl_reader"), I_val, &ibex_nl_reader, const_cast<char*>("Reader of the .nl file: 0 = ASL, 1 = native (memory-mapped, falls back to the ASL on unsupported segments). Default: 0. ")),
+		KW(const_cast<char*>("nl_threads"), I_val, &ibex_nl_threads, const_cast<char*>("Number of threads parsing the .nl file with the native reader (0 = one per core). Default: 1. ")),
 		KW(const_cast<char*>("obj_numb"),  I_val, &ibex_objno, const_cast<char*>("Choose which objective function of the AMPL model: 0 = none, 1 = first. Default: 1.")),
+		KW(const_cast<char*>("presolve"), I_val, &ibex_presolve, const_cast<char*>("Reduce the model when it is loaded (1): the fixed variables are replaced by their value and removed from the system, the linear constraints are used to tighten the bounds, the ones on a single variable, redundant or parallel to another one being removed. Default: 0. ")),
 		KW(const_cast<char*>("random_seed"), I_val, &ibex_random_seed, const_cast<char*>("Random seed (useful for reproducibility). Default: 1. ")),
 		KW(const_cast<char*>("rel_eps_f"), D_val, &ibex_rel_eps_f, const_cast<char*>("Relative precision on the objective. Default value is 1e-3. ")),
-		KW(const_cast<char*>("rigor"), I_val, &ibex_rigor, const_cast<char*>("Activate rigor mode (certify feasibility of equalities). If true, feasibility of equalities is certified. Default: 0. ")),
+		KW(const_cast<char*>("rigor"), I_val, &ibex_rigor, const_cast<char*>("Activate rigor mode (certify feasibility of equalities). If true, feasibility of equalities is certified (optimization only: the solutions of a model without objective are always certified). Default: 0. ")),
+		KW(const_cast<char*>("simpl_budget"), D_val, &ibex_simpl_budget, const_cast<char*>("Time budget (in seconds) of the adaptive simplification. If positive, the simplification level of each constraint is chosen according to its size and to the time left (simpl_level being the maximal level). The time is checked between two expressions: the simplification of one expression is not interrupted. Default: -1 (same level for all the constraints). ")),
 		KW(const_cast<char*>("simpl_level"), I_val, &ibex_simpl_level, const_cast<char*>("Expression simplification level. Possible values are:\n \t\t* 0:\t no simplification at all (fast).\n \t\t* 1:\t basic simplifications (fairly fast). E.g. x+1+1 --> x+2\n \t\t* 2:\t more advanced simplifications without developing (can be slow). E.g. x*x + x^2 --> 2x^2\n \t\t* 3:\t simplifications with full polynomial developing (can blow up!). E.g. x*(x-1) + x --> x^2\n Default value is : 1.")),
+		KW(const_cast<char*>("start_priority"), I_val, &ibex_start_priority, const_cast<char*>("Number of nodes at the beginning of the search where the boxes containing the start point (suffix ibex_start of the variables, or initial point of the model) are explored first. Default: 0 (none). ")),
+		KW(const_cast<char*>("streaming"), I_val, &ibex_streaming, const_cast<char*>("Read, translate and add each constraint in turn, releasing what is read in the .nl file (1). Uses the native reader unless nl_reader=0: the model read by the ASL is kept until the end. Default: 0. ")),
 		KW(const_cast<char*>("timeout"), D_val, &ibex_timeout, const_cast<char*>("Timeout (time in seconds). Default: -1 (none). ")),
 		KW(const_cast<char*>("trace"), I_val, &ibex_trace2, const_cast<char*>("Activate trace. Updates of lower and upper bound are printed while minimizing. Default: 0 (none). ")),
 		KW(const_cast<char*>("version"), Ver_val, 0, const_cast<char*>("report version")),
-		KW(const_cast<char*>("wantsol"), WS_val, 0, WS_desc_ASL+5)
+		KW(const_cast<char*>("wantsol"), WS_val, 0, WS_desc_ASL+5),
+		KW(const_cast<char*>("warm_start"), I_val, &ibex_warm_start, const_cast<char*>("Seed the upper bound of the objective with the initial point of the model (improved locally) if it is feasible (1). With -AMPL only. Default: 0. "))
 };
 
+// The suffix of the variables giving the start point (see AmplInterface::get_start_point())
+static SufDecl suftab[] = {
+		{ const_cast<char*>("ibex_start"), 0, ASL_Sufkind_var | ASL_Sufkind_real, 0 }
+};
 
 static std::string xxxvers = (std::string)("IbexOpt/AMPL Version ")+ (_IBEX_RELEASE_) + (std::string)("\n");
 
@@ -92,24 +128,53 @@ AmplInterface::AmplInterface(std::string nlfile) :
 		asl(NULL),
 		_nlfile(nlfile),
 		_x(NULL),
+		reader(NULL),
+		nl_offset(0),
+		obj_nl(NULL),
+		obj_sense(0),
+		jac_nnz(0),
+		jac_goff(true),
+		nb_nodes(0),
+		nb_shared_nodes(0),
+		nb_folded(0),
+		nb_pending_rows(0),
+		max_pending_rows(0),
+		nb_fixed(0),
+		nb_bound_rows(0),
+		nb_redundant_rows(0),
+		nb_tightened(0),
+		nb_duplicate_rows(0),
+		nb_components(1),
+		simpl_symbols(NULL),
+		simpl_max_level(3),
+		simpl_time(0),
 		abs_eps_f(OptimizerConfig::default_abs_eps_f),
+		aux_vars(0),
+		blocks(0),
+		decompose(0),
 		eps_h(ExtendedSystem::default_eps_h),
+		first_sol(0),
 		init_obj_value(POS_INFINITY),
 		inHC4(-1),
 		kkt(-1),
+		lazy(0),
+		linear_form(0),
+		nl_reader(0),
+		nl_threads(1),
 		obj_numb(1),
+		presolve(0),
 		random_seed(DefaultOptimizerConfig::default_random_seed),
 		rel_eps_f(OptimizerConfig::default_rel_eps_f),
 		rigor(-1),
+		simpl_budget(-1),
+		start_priority(0),
+		streaming(0),
 		timeout(OptimizerConfig::default_timeout),
 		//trace(OptimizerConfig::default_trace)
-		trace (1) {
+		trace (1),
+		warm_start(0) {
 
-	size_t i=0;
-	while (i<N_OPS) {
-		opmap[ Intcast (r_ops[i]) ] = i;
-		i++;
-	}
+	std::fill(simpl_count, simpl_count+4, 0);
 
 	if (!readASLfg()) {
 		ibex_error("Fail to read the ampl file.\n");
@@ -128,21 +193,34 @@ AmplInterface::AmplInterface(std::string nlfile) :
 }
 
 AmplInterface::~AmplInterface() {
+	// the expressions replaced by their simplified copies, except the
+	// nodes shared with the expressions given as is (the system's ones)
+	for (std::set<const ExprNode*>::const_iterator it=simpl_originals.begin(); it!=simpl_originals.end(); ++it)
+		if (simpl_kept.find(*it)==simpl_kept.end())
+			delete *it;
+	if (simpl_symbols) delete simpl_symbols;
+
 	for (int i =0; i< n_var;i++) {
 			if (_x[i]) delete _x[i];
 	}
+	for (size_t j =0; j< _aux.size();j++) {
+			delete _aux[j];
+	}
 
 	var_data.clear();
-	opmap.clear();
+	if (reader) delete reader;
 	if (asl) {
 		ASL_free(&asl);
 	}
 }
 
 bool AmplInterface::writeSolution(Optimizer& o) {
+	return writeSolution(o.get_status(), o.get_loup_point(), o.timeout);
+}
+
+bool AmplInterface::writeSolution(Optimizer::Status status, const IntervalVector& loup_point, double time_limit) {
 	std::stringstream message;
 	message << "IbexOpt "<< _IBEX_RELEASE_ << " finish : ";
-	Optimizer::Status status =o.get_status();
 	switch(status) {
 		case Optimizer::SUCCESS: {
 			message << " OPTIMIZATION SUCCESS! \n "
@@ -153,7 +231,7 @@ bool AmplInterface::writeSolution(Optimizer& o) {
 			solve_result_num=0;
 
 			std::string tmp = message.str();
-			Vector sol = o.get_loup_point().mid();
+			Vector sol = ampl_point(loup_point.mid());
 			write_sol(tmp.c_str(), sol.raw(), NULL, NULL);
 			break;
 		}
@@ -191,16 +269,16 @@ bool AmplInterface::writeSolution(Optimizer& o) {
 			solve_result_num=300;
 
 			std::string tmp = message.str();
-			Vector sol = o.get_loup_point().mid();
+			Vector sol = ampl_point(loup_point.mid());
 			write_sol(tmp.c_str(), sol.raw(), NULL, NULL);
 			break;
 		}
 		case Optimizer::TIME_OUT:{
-			message << " time limit " << o.timeout << "s. reached";
+			message << " time limit " << time_limit << "s. reached";
 			solve_result_num=400;
 
 			std::string tmp = message.str();
-			Vector sol = o.get_loup_point().mid();
+			Vector sol = ampl_point(loup_point.mid());
 			write_sol(tmp.c_str(), sol.raw(), NULL, NULL);
 			break;
 		}
@@ -217,7 +295,7 @@ bool AmplInterface::writeSolution(Optimizer& o) {
 			solve_result_num=402;
 
 			std::string tmp = message.str();
-			Vector sol = o.get_loup_point().mid();
+			Vector sol = ampl_point(loup_point.mid());
 			write_sol(tmp.c_str(), sol.raw(), NULL, NULL);
 			break;
 		}
@@ -225,8 +303,104 @@ bool AmplInterface::writeSolution(Optimizer& o) {
 	return true;
 }
 
+bool AmplInterface::get_x0(Vector& x) const {
+	if (!X0 || !_aux.empty()) return false;
+	for (int j = 0; j < n_var; j++)
+		if (var_index[j]>=0) x[var_index[j]] = X0[j];
+	return true;
+}
+
+bool AmplInterface::get_start_point(Vector& x) const {
+	if (start_suffix.empty()) return get_x0(x);
+	if (!_aux.empty()) return false;
+	for (int j = 0; j < n_var; j++)
+		if (var_index[j]>=0) x[var_index[j]] = start_suffix[j];
+	return true;
+}
+
+bool AmplInterface::writeSolution(Solver& s, Solver::Status status) {
+	std::stringstream message;
+	message << "IbexSolve "<< _IBEX_RELEASE_ << " finish : ";
+	const CovSolverData& data = s.get_data();
+
+	if (data.nb_solution()>0) {
+		message << " FEASIBLE POINT FOUND. \n "
+				<< "The point is the center of a box certified to contain \n"
+				<< "a solution (the equalities are not relaxed: \"eps_h\" \n"
+				<< "and \"rigor\" only apply to optimization).";
+		solve_result_num=0;
+
+		std::string tmp = message.str();
+		Vector sol = ampl_point(data.solution(0).mid());
+		write_sol(tmp.c_str(), sol.raw(), NULL, NULL);
+	} else if (data.nb_boundary()>0 || data.nb_unknown()>0) {
+		message << " FEASIBLE POINT NOT CERTIFIED. \n "
+				<< "No box could be certified to contain a solution. The point \n"
+				<< "is the center of a box of the precision required that \n"
+				<< "may contain one.";
+		solve_result_num=(status==Solver::TIME_OUT) ? 400 : 100;
+
+		std::string tmp = message.str();
+		Vector sol = ampl_point(data.nb_boundary()>0 ? data.boundary(0).mid() : data.unknown(0).mid());
+		write_sol(tmp.c_str(), sol.raw(), NULL, NULL);
+	} else {
+		switch(status) {
+		case Solver::INFEASIBLE:
+			message << " INFEASIBLE PROBLEM. \n "
+					<< "No solution exists in the initial box.";
+			solve_result_num=200;
+			break;
+		case Solver::TIME_OUT:
+			message << " time limit " << s.time_limit << "s. reached";
+			solve_result_num=400;
+			break;
+		default:
+			message << " CELL OVERFLOW. \n "
+					<< "The limit on the number of cells was reached.";
+			solve_result_num=401;
+			break;
+		}
+		std::string tmp = message.str();
+		write_sol(tmp.c_str(), NULL, NULL, NULL);
+	}
+	return true;
+}
+
+
+
 
+// Finds the fixed variables (if presolve is set): var_index[i] is the index
+// of the i-th variable in the system, or -1 if it is fixed to var_value[i].
+void AmplInterface::fix_vars() {
+	var_index.assign(n_var, -1);
+	var_value.assign(n_var, 0.0);
+	nb_fixed = 0;
+	int k = 0;
+	for (int i=0; i<n_var; i++) {
+		double lb = LUv ? (Uvx ? LUv[i] : LUv[2*i]) : negInfinity;
+		double ub = LUv ? (Uvx ? Uvx[i] : LUv[2*i+1]) : Infinity;
+		if (presolve==1 && lb==ub && negInfinity<lb && ub<Infinity) {
+			var_value[i] = lb;
+			nb_fixed++;
+		} else
+			var_index[i] = k++;
+	}
+	// a system needs a variable: if all of them are fixed, none is removed
+	if (k==0) {
+		for (int i=0; i<n_var; i++)
+			var_index[i] = i;
+		nb_fixed = 0;
+	}
+}
 
+// The point of the AMPL model (with the values of the fixed
+// variables) corresponding to a point x of the system.
+Vector AmplInterface::ampl_point(const Vector& x) const {
+	Vector res(n_var);
+	for (int i=0; i<n_var; i++)
+		res[i] = var_index[i] < 0 ? var_value[i] : x[var_index[i]];
+	return res;
+}
 
 // Reads a NLP from an AMPL .nl file through the ASL methods
 bool AmplInterface::readASLfg() {
@@ -243,6 +417,8 @@ bool AmplInterface::readASLfg() {
 	// Create the ASL structure
 	asl = (ASL*) ASL_alloc (ASL_read_fg);
 
+	reset_keywords();
+
 	char* stub = getstub (&argv, &Oinfo);
 	getopts (argv, &Oinfo);
 	//getstops =  getstub + getopts
@@ -250,19 +426,78 @@ bool AmplInterface::readASLfg() {
 	// Although very intuitive, we shall explain why the second argument
 	// is passed with a minus sign: it is to tell the ASL to retrieve
 	// the nonlinear information too.
+	suf_declare(suftab, sizeof(suftab)/sizeof(SufDecl));
 	FILE* nl = jac0dim (stub, - (fint) strlen (stub));
 
 	// Set options in the asl structure
 	want_xpi0 = 1 | 2;  // allocate initial values for primal and dual if available
 	obj_no = 0;         // always want to work with the first (and only?) objective
 
-	// read the rest of the nl file
-	fg_read (nl, ASL_return_read_err | ASL_findgroups);
+	// read the segments with the native reader if they are all supported
+	// (the file is then closed: the expressions are translated in readnl).
+	// The streaming mode needs it, unless the ASL is required: the DAG
+	// of the ASL is only freed with the whole ASL structure.
+	nl_offset = ftell(nl);
+	bool native = ibex_nl_reader>0 || (ibex_streaming>0 && ibex_nl_reader<0);
+	if (native && binary_nl<=1) {
+		reader = new NlReader(asl->i.filename_, nl_offset);
+		if (reader->ok() && index_segments()) {
+			fclose(nl);
+			nl_reader = 1;
+			return true;
+		}
+		delete reader;
+		reader = NULL;
+	}
 
 	//FIXME freeing argv and argv[1] gives segfault !!!
 	//  free(argv[1]);
 	//  delete[] argv;
 
+	// read the rest of the nl file
+	return read_fg(nl);
+}
+
+// Reads the segments of the .nl file (from the current position of nl,
+// closed by fg_read) with the ASL.
+bool AmplInterface::read_fg(FILE* nl) {
+	if (fg_read (nl, ASL_return_read_err | ASL_findgroups | ASL_want_A_vals))
+		return false;
+
+	// keep the start point given by suffix
+	SufDesc* start = suf_get("ibex_start", ASL_Sufkind_var);
+	if (start && (start->kind & ASL_Sufkind_input) && start->u.r)
+		start_suffix.assign(start->u.r, start->u.r+n_var);
+
+	return true;
+}
+
+// Reads the model with the ASL when the native reader fails while building
+// it (index_segments only checks the structure of the segments). What the
+// native reader has read is dropped, except the nodes in the hash-consing
+// table: the ASL translation finds them again.
+bool AmplInterface::fallback_asl() {
+	nl_reader = 0;
+	std::vector<const ExprNode*>().swap(con_nl);
+	std::vector<int>().swap(jac_row);
+	std::vector<int>().swap(jac_var);
+	std::vector<double>().swap(jac_coef);
+	obj_nl = NULL;
+	obj_var.clear();
+	obj_coef.clear();
+	var_data.assign(var_data.size(), NULL);
+	con_pos.clear();
+	nb_pending_rows = 0;
+	LUv = Uvx = LUrhs = Urhsx = NULL;
+
+	FILE* nl = fopen(asl->i.filename_, "rb");
+	if (!nl) return false;
+	if (fseek(nl, nl_offset, SEEK_SET)!=0) {
+		fclose(nl);
+		return false;
+	}
+	if (!read_fg(nl)) return false;
+	fix_vars();
 	return true;
 }
 
@@ -274,6 +509,10 @@ bool AmplInterface::readoption() {
 	if (ibex_abs_eps_f>0) {
 		set_abs_eps_f(ibex_abs_eps_f);
 	}
+
+	if (ibex_aux_vars>=0) {
+		set_aux_vars(ibex_aux_vars);
+	}
 	if (ibex_rel_eps_f>0) {
 		set_rel_eps_f ( ibex_rel_eps_f);
 	}
@@ -294,6 +533,15 @@ bool AmplInterface::readoption() {
 		set_simplification_level ( ibex_simpl_level);
 	}
 
+	if (ibex_simpl_budget>0) {
+		set_simpl_budget(ibex_simpl_budget);
+		// the expressions are simplified when they are translated,
+		// simpl_level (if given) being the maximal level
+		if (ibex_simpl_level>=0 && ibex_simpl_level<=3)
+			simpl_max_level = ibex_simpl_level;
+		set_simplification_level(0);
+	}
+
 	if (ibex_initial_loup !=-12345) {
 		set_init_obj_value ( ibex_initial_loup);
 	} else {
@@ -308,6 +556,30 @@ bool AmplInterface::readoption() {
 		set_inHC4(ibex_inHC4==1);
 	}
 
+	if (ibex_presolve>=0) {
+		set_presolve(ibex_presolve);
+	}
+
+	if (ibex_decompose>=0) {
+		set_decompose(ibex_decompose);
+	}
+
+	if (ibex_blocks>=0) {
+		set_blocks(ibex_blocks);
+	}
+
+	if (ibex_first_sol>=0) {
+		set_first_sol(ibex_first_sol);
+	}
+
+	if (ibex_warm_start>=0) {
+		set_warm_start(ibex_warm_start);
+	}
+
+	if (ibex_start_priority>=0) {
+		set_start_priority(ibex_start_priority);
+	}
+
 	if (ibex_kkt>=0) {
 		set_kkt(ibex_kkt==1);
 	}
@@ -320,6 +592,22 @@ bool AmplInterface::readoption() {
 		set_trace(ibex_trace2);
 	}
 
+	if (ibex_linear_form>=0) {
+		set_linear_form(ibex_linear_form);
+	}
+
+	if (ibex_nl_threads>=0) {
+		set_nl_threads(ibex_nl_threads);
+	}
+
+	if (ibex_lazy>=0) {
+		set_lazy(ibex_lazy);
+	}
+
+	if (ibex_streaming>=0) {
+		set_streaming(ibex_streaming);
+	}
+
 	return true;
 }
 
@@ -330,7 +618,7 @@ bool AmplInterface::readnl() {
 
 	// the variable /////////////////////////////////////////////////////////////
 	// TODO only continuous variables for the moment
-	// TODO get the x0 : see ((expr_v *) e) -> v , havex0 and X0
+	// (the initial point X0 is read by the ASL, see get_x0())
 
 	_x= new const ExprSymbol*[n_var];
 	for (int i =0; i< n_var; i++) {
@@ -339,6 +627,28 @@ bool AmplInterface::readnl() {
 	//_x =new Variable(n_var,"x");
 	IntervalVector bound(n_var);
 
+	// the expressions of the defined variables, translated on first use
+	int ncom = comb+comc+como+comc1+como1;
+	var_data.assign(ncom, NULL);
+
+	// the auxiliary variables (one per defined variable)
+	if (aux_vars) {
+		for (int j =0; j< ncom; j++) {
+			std::stringstream name;
+			name << "_dv" << n_var+j;
+			_aux.push_back(&(ExprSymbol::new_(name.str().c_str(), Dim::scalar())));
+		}
+	}
+
+	// the symbols of the copies made by the adaptive simplification
+	if (simpl_budget>0) {
+		simpl_symbols = new Array<const ExprSymbol>(n_var+_aux.size());
+		for (int i =0; i< n_var; i++)
+			simpl_symbols->set_ref(i, *_x[i]);
+		for (size_t j =0; j< _aux.size(); j++)
+			simpl_symbols->set_ref(n_var+j, *_aux[j]);
+	}
+
 		// Each has a linear and a nonlinear part
 		// thanks to Dominique Orban:
 		//        http://www.gerad.ca/~orban/drampl/def-vars.html
@@ -346,6 +656,13 @@ bool AmplInterface::readnl() {
 
 	try {
 
+		// with the native reader, the segments are read (and the bounds set) here,
+		// or by the ASL if it fails
+		if (nl_reader==1) {
+			if (!read_native() && !fallback_asl()) return false;
+		} else
+			fix_vars();
+
 	// lower and upper bounds of the variables ///////////////////////////////////////////////////////////////
 		if (LUv) {
 			real *Uvx_copy = Uvx;
@@ -363,8 +680,24 @@ bool AmplInterface::readnl() {
 					bound[i] = Interval( LUv[i], Uvx_copy[i]);
 				}
 		} // else it is [-oo,+oo]
+
+		// the linear terms of the constraints, transposed once into row buffers
+		read_linear_rows();
+		std::vector<int>().swap(jac_row);
+		std::vector<int>().swap(jac_var);
+		std::vector<double>().swap(jac_coef);
+
+		ctr_expr.assign(n_con, NULL);
+		ctr_loaded.assign(n_con, false);
+
+		// the presolve of the linear constraints
+		if (presolve==1) presolve_rows(bound);
+
 		for (int i =0; i< n_var; i++) {
-			add_var(*(_x[i]),bound[i]);
+			if (var_index[i]>=0) add_var(*(_x[i]),bound[i]);
+		}
+		for (size_t j =0; j< _aux.size(); j++) {
+			add_var(*(_aux[j]),Interval::all_reals());
 		}
 		//add_var(*_x, bound);
 
@@ -373,428 +706,2131 @@ bool AmplInterface::readnl() {
 
 		//for (int i = 0; i < n_obj; i++) {
 		// Select the objective function
+		const ExprNode *obj_body = NULL;  // nonlinear part of the objective
 		if (n_obj>0 && get_obj_numb()>0) {
 			int i = get_obj_numb() -1 ;
-			///////////////////////////////////////////////////
-			//  the nonlinear part
-			const ExprNode *body = &(nl2expr ((OBJ_DE [i]).e));
-
-			////////////////////////////////////////////////
-			// The linear part
-			// count nonzero terms in linear part
-			double coeff;
-			int index;
-			for (ograd *objgrad = Ograd [i]; objgrad; objgrad = objgrad -> next) {
-				if ((dynamic_cast<const ExprConstant*>(body))&&(((ExprConstant*)(body))->is_zero())) {
-					delete body;
-					if (fabs (objgrad -> coef) != 0.0) {
-						coeff = objgrad -> coef;
-						index = objgrad -> varno;
-						if (coeff==1) {
-							body = ((_x[index]));
-						} else if (coeff==-1) {
-							body = &( - (*(_x[index])));
-						} else {
-							body = &(coeff * (*(_x[index])));
-						}
-					}
-				} else {
-					if (fabs (objgrad -> coef) != 0.0) {
-						coeff = objgrad -> coef;
-						index = objgrad -> varno;
-						if (coeff==1) {
-							body = &(*body + (*(_x[index])));
-						} else if (coeff==-1) {
-							body = &(*body - (*(_x[index])));
-						} else {
-							body = &(*body +coeff * (*(_x[index])));
-						}
-					}
+			const ExprNode *body;
+			int sense;
+			if (nl_reader==1) {
+				// already read (nonlinear and linear parts)
+				obj_body = obj_nl;
+				body = &(linear_sum(obj_nl, obj_var.size(), obj_var.data(), obj_coef.data()));
+				sense = obj_sense;
+			} else {
+				///////////////////////////////////////////////////
+				//  the nonlinear part
+				body = is_null((OBJ_DE [i]).e) ? NULL : &(nl2expr ((OBJ_DE [i]).e));
+				obj_body = body;
+
+				////////////////////////////////////////////////
+				// The linear part
+				lin_var.clear();
+				lin_coef.clear();
+				for (ograd *objgrad = Ograd [i]; objgrad; objgrad = objgrad -> next) {
+					lin_var.push_back(objgrad -> varno);
+					lin_coef.push_back(objgrad -> coef);
 				}
+				body = &(linear_sum(body, lin_var.size(), lin_var.data(), lin_coef.data()));
+				sense = OBJ_sense [i];
 			}
 
 			////////////////////////////////////////////////
 			// Max or Min
 			// 3rd/ASL/solvers/asl.h, line 336: 0 is minimization, 1 is maximization
-			if (OBJ_sense [i] == 0) {
-				add_goal(*body, obj_name(0));
+			if (sense == 0) {
+				add_goal(simplified(*body), obj_name(0));
 			} else {
-				add_goal(-(*body), obj_name(0));
+				add_goal(simplified(-(*body)), obj_name(0));
 			}
 		}
 
 	// constraints ///////////////////////////////////////////////////////////////////
-		// allocate space for argument list of all constraints' summations
-		// of linear and nonlinear terms
-		const ExprNode **body_con = new const ExprNode*[n_con];
-		///////////////////////////////////////////////////
-		// The nonlinear part :
-		//init array of each constraint with the nonlinear part
-		for (int i = 0; i<n_con;i++)
-			body_con[i] = &(nl2expr (CON_DE [i] . e));
-
-		///////////////////////////////////////////////////
-		// count all linear terms
-		if (A_colstarts && A_vals)    {      // Constraints' linear info is stored in A_vals
-			for (int j = 0; j < n_var; j++){
-				for (int i = A_colstarts [j], k = A_colstarts [j+1] - i; k--; i++) {
-					if ((dynamic_cast<const ExprConstant*>(body_con[A_rownos[i]]))&&(((ExprConstant*)(body_con[A_rownos[i]]))->is_zero())) {
-						delete body_con[A_rownos[i]];
-						if (A_vals[i]==1) {
-							body_con[A_rownos[i]] = (((_x[j])));
-						} else if (A_vals[i]==-1) {
-							body_con[A_rownos[i]] = &(- (*(_x[j])));
-						} else {
-							body_con[A_rownos[i]] = &((A_vals[i]) * (*(_x[j])));
-						}
-					} else {
-						if (A_vals[i]==1) {
-							body_con[A_rownos[i]] = &(*(body_con[A_rownos[i]]) + (*(_x[j])));
-						} else if (A_vals[i]==-1) {
-							body_con[A_rownos[i]] = &(*(body_con[A_rownos[i]]) - (*(_x[j])));
-						} else {
-							body_con[A_rownos[i]] = &(*(body_con[A_rownos[i]]) + (A_vals[i]) * (*(_x[j])));
-						}
-					}
-
-				}
+		// the duplicate and parallel constraints (presolve), except when
+		// the constraints are read one by one
+		if (presolve==1 && !lazy && !streaming) merge_rows();
+
+		// each constraint is built in one pass: nonlinear part, linear part and bounds
+		if (!lazy) {
+			for (int i = 0; i < n_con; i++) {
+				if (!load_row(i)) return false;
 			}
-		} else {		// Constraints' linear info is stored in Cgrad
-			cgrad *congrad;
-			double coeff;
-			int index;
-			for ( int i = 0; i < n_con; i++)
-				for (congrad = Cgrad [i]; congrad; congrad = congrad -> next) {
-					if ((dynamic_cast<const ExprConstant*>(body_con[i]))&&(((ExprConstant*)(body_con[i]))->is_zero())) {
-						delete body_con[i];
-						coeff = congrad -> coef;
-						if (fabs (coeff) != 0.0) {
-							index = congrad -> varno;
-							if (coeff==1) {
-								body_con[i] = ( ((_x[index])));
-							} else if (coeff==-1) {
-								body_con[i] = &(-(*(_x[index])));
-							} else {
-								body_con[i] = &((coeff) * (*(_x[index])));
-							}
-						}
+		}
 
-					} else {
-						coeff = congrad -> coef;
-						if (fabs (coeff) != 0.0) {
-							index = congrad -> varno;
-							if (coeff==1) {
-								body_con[i] = &(*(body_con[i]) + (*(_x[index])));
-							} else if (coeff==-1) {
-								body_con[i] = &(*(body_con[i]) - (*(_x[index])));
-							} else {
-								body_con[i] = &(*(body_con[i]) + (coeff) * (*(_x[index])));
-							}
-						}
-					}
-				}
+		// the defining equalities of the auxiliary variables, after the constraints
+		for (size_t j = 0; j < _aux.size(); j++) {
+			add_ctr_eq(simplified(*_aux[j] - defined_var(n_var+j)));
+			ctr_rows.push_back(-1);
 		}
-		///////////////////////////////////////////////////
-		// Kind of constraints : equality, inequality
-		for (int i = 0; i < n_con; i++) {
-			int sig;
-			double lb, ub;
 
-			/* LUrhs is the constraint lower bound if Urhsx!=0, and the constraint lower and upper bound if Uvx == 0 */
-			if (Urhsx) {
-				lb = LUrhs [i];
-				ub = Urhsx [i];
-			} else {
-				lb = LUrhs [2*i];
-				ub = LUrhs [2*i+1];
-			}
+		// the independent subproblems and the blocks of equations
+		find_components(obj_body);
+		find_blocks();
 
-			// set constraint sign
-			if (negInfinity < lb)
-				if (ub < Infinity)  sig =1; // EQ;
-				else                sig =2; // GEQ;
-			else                    sig =3; // LEQ;
-
-			// add them (and set lower-upper bound)
-			switch (sig) {
-
-			case  1:  {
-				if (lb==ub) {
-					if (lb==0) {
-						add_ctr_eq((*(body_con[i])));
-					} else if (lb<0) {
-						add_ctr_eq((*(body_con[i])+(-lb)));
-					} else {
-						add_ctr_eq((*(body_con[i])-lb));
-					}
-				} else  {
-					 std::string name1 = "_1";
-					 name1 = con_name(i)+name1;
-					 std::string name2 = "_2";
-					 name2 = con_name(i)+name2;
-					 add_ctr(ExprCtr(*(body_con[i])-ub, LEQ), name1.c_str());
-					 add_ctr(ExprCtr(*(body_con[i])-lb, GEQ), name2.c_str());
-				}
-				break;
-			}
-			case  2:  {
-				if (lb==0) {
-					add_ctr(ExprCtr(*(body_con[i]),GEQ),con_name(i));
-				} else if (lb<0) {
-					add_ctr(ExprCtr(*(body_con[i])+(-lb),GEQ),con_name(i));
-				} else {
-					add_ctr(ExprCtr(*(body_con[i])-lb,GEQ),con_name(i));
-				}
-				break;
-			}
-			case  3: {
-				if (ub==0) {
-					add_ctr(ExprCtr(*(body_con[i]),LEQ),con_name(i));
-				} else if (ub<0) {
-					add_ctr(ExprCtr(*(body_con[i])+(-ub),LEQ),con_name(i));
-				} else {
-					add_ctr(ExprCtr(*(body_con[i])-ub,LEQ),con_name(i));
-				}
-				break;
+	} catch (...) {
+		node_table.clear();
+		return false;
+	}
+
+	// the nodes belong to the system from now on
+	// (in lazy mode, the table is kept for the constraints translated later)
+	if (!lazy) {
+		node_table.clear();
+		release_data();
+	}
+
+	return true;
+}
+
+// Releases the data read in the .nl file once all the constraints are added.
+void AmplInterface::release_data() {
+	con_pos.clear();
+	if (reader) {
+		delete reader;
+		reader = NULL;
+	}
+	std::vector<const ExprNode*>().swap(con_nl);
+	std::vector<Interval>().swap(row_rhs);
+	std::vector<int>().swap(row_start);
+	std::vector<int>().swap(row_var);
+	std::vector<double>().swap(row_coef);
+	std::vector<const ExprNode*>().swap(var_data);
+}
+
+// Adds the i-th constraint to the system, unless it has already been added.
+bool AmplInterface::load_row(int i) {
+	if (ctr_loaded[i]) return true;
+	ctr_loaded[i] = true;
+	if (!add_row(i, get_ctr_expr(i))) return false;
+	if (nb_pending_rows>0) nb_pending_rows--;
+	return true;
+}
+
+void AmplInterface::count_pending_row() {
+	nb_pending_rows++;
+	if (nb_pending_rows>max_pending_rows)
+		max_pending_rows = nb_pending_rows;
+}
+
+int AmplInterface::get_nb_ampl_ctr() const {
+	return n_con;
+}
+
+int AmplInterface::find_ctr(const std::string& name) {
+	if (ctr_index.empty()) {
+		for (int i = 0; i < n_con; i++)
+			ctr_index[con_name(i)] = i;
+	}
+	std::map<std::string,int>::const_iterator it = ctr_index.find(name);
+	return it==ctr_index.end() ? -1 : it->second;
+}
+
+const ExprNode& AmplInterface::get_ctr_expr(int i) {
+	if (i<0 || i>=n_con) {
+		ibex_error("Error AmplInterface: constraint index out of range\n");
+	}
+	if (!ctr_expr[i])
+		ctr_expr[i] = &row_expr(i);
+	return *ctr_expr[i];
+}
+
+Interval AmplInterface::get_ctr_bounds(int i) const {
+	if (i<0 || i>=n_con) {
+		ibex_error("Error AmplInterface: constraint index out of range\n");
+	}
+	if (Urhsx)
+		return Interval(LUrhs [i], Urhsx [i]);
+	else
+		return Interval(LUrhs [2*i], LUrhs [2*i+1]);
+}
+
+void AmplInterface::load_ctr(int i) {
+	if (!load_row(i)) {
+		ibex_error("Error AmplInterface: fail to load a constraint\n");
+	}
+}
+
+void AmplInterface::load_ctr(const std::string& name) {
+	int i = find_ctr(name);
+	if (i<0) {
+		ibex_error("Error AmplInterface: unknown constraint\n");
+	}
+	load_ctr(i);
+}
+
+void AmplInterface::load_all_ctrs() {
+	for (int i = 0; i < n_con; i++)
+		load_ctr(i);
+}
+
+// Transposes the linear part of the constraints (stored column by column
+// in A_vals, or in the Cgrad lists) into the row buffers.
+void AmplInterface::read_linear_rows() {
+	row_start.assign(n_con+1, 0);
+
+	if (nl_reader==1) {                  // Constraints' linear info read in the J segments
+		int nz = jac_row.size();
+		for (int i = 0; i < nz; i++)
+			row_start[jac_row[i]+1]++;
+		for (int i = 0; i < n_con; i++)
+			row_start[i+1] += row_start[i];
+
+		row_var.resize(nz);
+		row_coef.resize(nz);
+		std::vector<int> pos(row_start.begin(), row_start.end()-1);
+		for (int i = 0; i < nz; i++) {
+			int k = pos[jac_row[i]]++;
+			row_var[k] = jac_var[i];
+			row_coef[k] = jac_coef[i];
+		}
+	} else if (A_colstarts && A_vals)    {      // Constraints' linear info is stored in A_vals
+		int nz = A_colstarts [n_var];
+		// counting sort on the row numbers
+		for (int i = 0; i < nz; i++)
+			row_start[A_rownos[i]+1]++;
+		for (int i = 0; i < n_con; i++)
+			row_start[i+1] += row_start[i];
+
+		row_var.resize(nz);
+		row_coef.resize(nz);
+		std::vector<int> pos(row_start.begin(), row_start.end()-1);
+		for (int j = 0; j < n_var; j++) {
+			for (int i = A_colstarts [j]; i < A_colstarts [j+1]; i++) {
+				int k = pos[A_rownos[i]]++;
+				row_var[k] = j;
+				row_coef[k] = A_vals[i];
 			}
-			default: ibex_error("Error: could not recognize a constraint\n"); return false;
+		}
+	} else {		// Constraints' linear info is stored in Cgrad
+		for (int i = 0; i < n_con; i++) {
+			row_start[i+1] = row_start[i];
+			for (cgrad *congrad = Cgrad [i]; congrad; congrad = congrad -> next)
+				row_start[i+1]++;
+		}
+
+		row_var.resize(row_start[n_con]);
+		row_coef.resize(row_start[n_con]);
+		for (int i = 0; i < n_con; i++) {
+			int k = row_start[i];
+			for (cgrad *congrad = Cgrad [i]; congrad; congrad = congrad -> next, k++) {
+				row_var[k] = congrad -> varno;
+				row_coef[k] = congrad -> coef;
 			}
 		}
+	}
+}
+
+// Nonlinear part of the i-th constraint (NULL if none). With the ASL, it is
+// translated once if con_nl is allocated (see merge_rows()).
+const ExprNode* AmplInterface::row_nl(int i) {
+	if (nl_reader==1) {
+		if (con_pos.size()>0 && con_pos[i]>0) {
+			// lazy mode with the native reader: read the "C" segment now
+			reader->seek(con_pos[i]);
+			reader->read_char();
+			reader->read_int();
+			reader->next_line();
+			con_nl[i] = read_body(*reader, NULL);
+			con_pos[i] = 0;
+			count_pending_row();
+		}
+		return con_nl[i];
+	}
+	if (is_null(CON_DE [i] . e))
+		return NULL;
+	if (con_nl.empty())
+		return &(nl2expr (CON_DE [i] . e));
+	if (!con_nl[i])
+		con_nl[i] = &(nl2expr (CON_DE [i] . e));
+	return con_nl[i];
+}
 
+// Body of the i-th constraint: its nonlinear part plus its linear part.
+const ExprNode& AmplInterface::row_expr(int i) {
+	const ExprNode *body = row_nl(i);
+	int k = row_start[i];
+	return linear_sum(body, row_start[i+1]-k, row_var.data()+k, row_coef.data()+k);
+}
 
-		delete[] body_con;
+// The linear terms coef[k]*x[var[k]] of the i-th constraint on the variables
+// that are not fixed, and the sum b of the other ones.
+void AmplInterface::row_terms(int i, std::vector<int>& var, std::vector<double>& coef, Interval& b) {
+	var.clear();
+	coef.clear();
+	b = Interval::zero();
+	for (int k = row_start[i]; k < row_start[i+1]; k++) {
+		if (row_coef[k] == 0) continue;
+		int v = row_var[k];
+		if (var_index[v] < 0)
+			b += row_coef[k] * Interval(var_value[v]);
+		else {
+			var.push_back(v);
+			coef.push_back(row_coef[k]);
+		}
+	}
+}
 
-	} catch (...) {
-		return false;
+namespace {
+
+// Hash code of a constraint nl + sum coef[k]*x[var[k]], with the
+// coefficients divided by scale.
+size_t row_hash(const ExprNode* nl, const std::vector<int>& var, const std::vector<double>& coef, double scale) {
+	size_t h = (size_t) nl;
+	for (size_t k=0; k<var.size(); k++) {
+		double c = coef[k]/scale + 0.0;
+		unsigned char p[sizeof(double)];
+		memcpy(p, &c, sizeof(double));
+		h = (h*1000003) ^ var[k];
+		for (size_t j=0; j<sizeof(double); j++)
+			h = h*31 + p[j];
 	}
+	return h;
+}
 
+// If the linear terms (var2,coef2) are exactly lambda times (var1,coef1),
+// returns true and sets lambda.
+bool proportional(const std::vector<int>& var1, const std::vector<double>& coef1,
+		const std::vector<int>& var2, const std::vector<double>& coef2, Interval& lambda) {
+	if (var1!=var2) return false;
+	lambda = Interval(1);
+	for (size_t k=0; k<var1.size(); k++) {
+		// the division must be exact
+		Interval r = Interval(coef2[k]) / coef1[k];
+		if (!r.is_degenerated() || (k>0 && r!=lambda)) return false;
+		lambda = r;
+	}
 	return true;
 }
 
-// converts an AMPL expression (sub)tree into an expression* (sub)tree
-// thank to Dominique Orban for the explication of the DAG inside AMPL:
-// http://www.gerad.ca/~orban/drampl/dag.html
-const ExprNode& AmplInterface::nl2expr(expr *e) {
-
-	switch (opmap[Intcast (e -> op)]) {
+}
 
-	case OPNUM:    return  (ExprConstant::new_scalar(((expr_n *)e)->v));
-	case OPPLUS:   {
-		if (opmap[Intcast (e->R.e->op)]==OPUMINUS) {
-			return  (( nl2expr(e -> L.e)) - nl2expr((e->R.e)->L.e) );
-		} else {
-			if (opmap[Intcast (e->L.e->op)]==OPUMINUS) {
-				return  (nl2expr(e->R.e) - nl2expr((e->L.e)->L.e) );
-			} else {
-				return  (nl2expr(e->R.e) + nl2expr(e->L.e) );
-			}
+// Detection of the duplicate and parallel constraints (presolve).
+//
+// Two constraints are parallel if they have the same nonlinear part (the
+// same node, thanks to the hash-consing) and if their linear parts are
+// proportional: exactly equal if there is a nonlinear part, or with an
+// exact ratio lambda otherwise. They are found by sorting the constraints
+// by the hash code of their canonical form (the linear coefficients being
+// divided by the first one). For each group of parallel constraints, only
+// the first one is added, its bounds being the intersection of the bounds
+// of all the constraints of the group (translated by interval arithmetic).
+void AmplInterface::merge_rows() {
+	if (nl_reader!=1) con_nl.assign(n_con, NULL);
+	row_rhs.resize(n_con);
+	for (int i = 0; i < n_con; i++)
+		row_rhs[i] = get_ctr_bounds(i);
+
+	std::vector<int> var1, var2;
+	std::vector<double> coef1, coef2;
+	Interval b1, b2;
+
+	std::vector<std::pair<size_t,int> > keys;
+	for (int i = 0; i < n_con; i++) {
+		if (ctr_loaded[i]) continue;
+		const ExprNode* nl = row_nl(i);
+		row_terms(i, var1, coef1, b1);
+		if (!nl && var1.empty()) continue; // left to the presolve
+		keys.push_back(std::make_pair(row_hash(nl, var1, coef1, nl || var1.empty() ? 1 : coef1[0]), i));
+	}
+	std::sort(keys.begin(), keys.end());
+
+	std::vector<int> reps; // the first constraints of the groups with the same hash code
+	for (size_t k = 0; k < keys.size(); k++) {
+		if (k==0 || keys[k].first!=keys[k-1].first)
+			reps.clear();
+
+		int i = keys[k].second;
+		const ExprNode* nl = row_nl(i);
+		row_terms(i, var2, coef2, b2);
+
+		bool merged = false;
+		for (size_t r = 0; !merged && r < reps.size(); r++) {
+			if (row_nl(reps[r])!=nl) continue;
+			row_terms(reps[r], var1, coef1, b1);
+			Interval lambda;
+			if (!proportional(var1, coef1, var2, coef2, lambda)) continue;
+			if (nl && lambda!=Interval(1)) continue;
+
+			// body_i = lambda*(body_r - b_r) + b_i
+			Interval rhs = row_rhs[reps[r]] & ((row_rhs[i] - b2) / lambda + b1);
+			if (rhs.is_empty()) continue; // kept (the system is infeasible)
+			row_rhs[reps[r]] = rhs;
+			ctr_loaded[i] = true;     // nothing to add
+			if (nb_pending_rows>0) nb_pending_rows--;
+			nb_duplicate_rows++;
+			merged = true;
 		}
+		if (!merged) reps.push_back(i);
 	}
-	case OPMINUS:  {
-		if (opmap[Intcast (e->R.e->op)]==OPUMINUS)  {
-			return (( nl2expr(e->L.e)) + nl2expr((e->R.e)->L.e) );
-		} else {
-			return  (( nl2expr(e->L.e)) - nl2expr(e->R.e));
+}
+
+namespace {
+
+// Maximal number of rounds of the presolve
+const int PRESOLVE_MAX_ROUNDS = 10;
+
+// Minimal relative reduction of a domain by the presolve
+const double PRESOLVE_MIN_GAIN = 0.01;
+
+// true if the domain y (included in x) is significantly smaller than x
+bool shrinks(const Interval& x, const Interval& y) {
+	if (y.is_empty()) return true;
+	if (x.diam()==POS_INFINITY)
+		return y.diam()<POS_INFINITY || y.lb()>x.lb() || y.ub()<x.ub();
+	return y.diam() < (1-PRESOLVE_MIN_GAIN)*x.diam();
+}
+
+}
+
+// true if the i-th constraint has no nonlinear part. With the native
+// reader in lazy or streaming mode, the nonlinear part is not read yet,
+// so the answer is false.
+bool AmplInterface::linear_row(int i) {
+	if (nl_reader==1)
+		return con_pos.empty() && !con_nl[i];
+	else
+		return is_null(CON_DE [i] . e);
+}
+
+// Presolve of the i-th constraint sum_k a_k*x_k + b in [lb,ub], b being the
+// sum of the terms of the fixed variables. The activity of the row (the range
+// of its body in the box) is computed in interval arithmetic. Returns true if
+// the constraint can be removed:
+// * if its activity is included in [lb,ub] (redundant constraint),
+// * if it has a single variable: x_k in ([lb,ub]-b)/a_k is put in its bounds.
+// Otherwise, the bounds of each x_k are tightened with the activity of the
+// other terms (if x_k is a bound of a forcing constraint, it is fixed).
+bool AmplInterface::presolve_row(int i, IntervalVector& bound, bool& changed) {
+	Interval rhs = get_ctr_bounds(i);
+
+	Interval b(0);
+	int nb = 0;         // number of variables
+	int last = -1;      // position of the last variable in the row buffers
+	// sums of the finite lower/upper bounds of the terms, and number of infinite ones
+	Interval lo_sum(0), hi_sum(0);
+	int lo_inf = 0, hi_inf = 0;
+
+	for (int k = row_start[i]; k < row_start[i+1]; k++) {
+		if (row_coef[k] == 0) continue;
+		int v = row_var[k];
+		if (var_index[v] < 0) {
+			b += row_coef[k] * Interval(var_value[v]);
+			continue;
 		}
+		nb++;
+		last = k;
+		Interval t = row_coef[k] * bound[v];
+		if (t.lb()==NEG_INFINITY) lo_inf++; else lo_sum += t.lb();
+		if (t.ub()==POS_INFINITY) hi_inf++; else hi_sum += t.ub();
 	}
-	case OPDIV:    return  (( nl2expr(e -> L.e)) / (nl2expr(e -> R.e)));
-	case OPMULT:   return  (operator*((nl2expr (e -> L.e)) , (nl2expr(e -> R.e))));
-	case OPPOW:    return  pow( nl2expr(e -> L.e), nl2expr(e -> R.e));
-	case OP1POW:   {
-		if (((int) (((expr_n *)e->R.e)->v) )==(((expr_n *)e->R.e)->v)) {
-			return pow( nl2expr(e -> L.e), (int) (((expr_n *)e->R.e)->v));
-		} else
-			return pow( nl2expr(e -> L.e), ExprConstant::new_scalar(((expr_n *)e->R.e)->v));
+	lo_sum += b.lb();
+	hi_sum += b.ub();
+
+	Interval act(lo_inf ? NEG_INFINITY : lo_sum.lb(), hi_inf ? POS_INFINITY : hi_sum.ub());
+	if (act.is_subset(rhs)) {
+		nb_redundant_rows++;
+		return true;
 	}
-	case OP2POW:   return sqr( nl2expr(e -> L.e));
-	case OPCPOW:   return pow(ExprConstant::new_scalar(((expr_n *)e->L.e)->v), nl2expr(e -> R.e));
-	case MINLIST: {
-		expr **ep = e->L.ep;
-		const ExprNode* ee = &(nl2expr(*ep));
-		ep++;
-		while (ep < e->R.ep) {
-			ee = &(min(*ee , nl2expr(*ep)));
-			ep++;
+
+	if (nb==1) {
+		int v = row_var[last];
+		bound[v] &= (rhs - b) / row_coef[last];
+		nb_bound_rows++;
+		changed = true;
+		return true;
+	}
+
+	for (int k = row_start[i]; k < row_start[i+1]; k++) {
+		int v = row_var[k];
+		if (row_coef[k] == 0 || var_index[v] < 0) continue;
+		Interval t = row_coef[k] * bound[v];
+		// activity of the other terms
+		double lo = (lo_inf > (t.lb()==NEG_INFINITY ? 1 : 0)) ? NEG_INFINITY :
+				(t.lb()==NEG_INFINITY ? lo_sum : lo_sum - t.lb()).lb();
+		double hi = (hi_inf > (t.ub()==POS_INFINITY ? 1 : 0)) ? POS_INFINITY :
+				(t.ub()==POS_INFINITY ? hi_sum : hi_sum - t.ub()).ub();
+		if (lo==NEG_INFINITY && hi==POS_INFINITY) continue;
+
+		Interval x = bound[v] & ((rhs - Interval(lo,hi)) / row_coef[k]);
+		if (shrinks(bound[v], x)) {
+			bound[v] = x;
+			nb_tightened++;
+			changed = true;
+			if (x.is_empty()) return false; // infeasible
 		}
-		return *ee;
 	}
-	case MAXLIST:  {
-		expr **ep = e->L.ep;
-		const ExprNode* ee = &(nl2expr(*ep));
-		ep++;
-		while (ep < e->R.ep) {
-			ee = &(max(*ee , nl2expr(*ep)));
-			ep++;
+	return false;
+}
+
+// The presolve of the linear constraints (see #presolve_row()), repeated
+// until no bound is tightened anymore. The constraints removed are not
+// added to the system.
+void AmplInterface::presolve_rows(IntervalVector& bound) {
+	bool changed = true;
+	for (int round = 0; changed && round < PRESOLVE_MAX_ROUNDS; round++) {
+		changed = false;
+		for (int i = 0; i < n_con; i++) {
+			if (ctr_loaded[i] || !linear_row(i)) continue;
+			if (presolve_row(i, bound, changed))
+				ctr_loaded[i] = true;  // nothing to add
+			if (bound.is_empty()) return; // the system is infeasible
 		}
-		return *ee;
 	}
-	case OPSUMLIST: {
-		expr **ep = e->L.ep;
-		const ExprNode* ee = &(nl2expr(*ep));
-		ep++;
-		while (ep < e->R.ep) {
-			if (opmap[Intcast ((*ep)->op)]==OPUMINUS) {
-				ee = &(*ee - nl2expr((*ep)->L.e) );
-			} else {
-				ee = &(*ee + nl2expr(*ep) );
-			}
-			ep++;
+
+	// the variables fixed by the presolve are removed too, unless
+	// the expressions are already built (native reader)
+	if (nl_reader!=1) {
+		int k = 0;
+		for (int v = 0; v < n_var; v++) {
+			if (var_index[v] < 0) continue;
+			if (bound[v].is_degenerated() && !bound[v].is_unbounded()) {
+				var_index[v] = -1;
+				var_value[v] = bound[v].lb();
+				nb_fixed++;
+			} else
+				var_index[v] = k++;
 		}
-		return *ee;
+		if (k==0) fix_vars(); // see fix_vars()
 	}
-	case ABS:      return abs( nl2expr(e -> L.e));
-	case OPUMINUS: {
-		if (opmap[Intcast (e->L.e->op)]==OPUMINUS)  {
-			return  (nl2expr((e -> L.e)->L.e));
-		} else {
-			return  (operator-(nl2expr(e -> L.e)));
-		}
-	}
-	case OP_sqrt:  return sqrt(nl2expr(e -> L.e));
-	case OP_exp:   return exp( nl2expr(e -> L.e));
-	case OP_log:   return log( nl2expr(e -> L.e));
-	case OP_log10: return ((ExprConstant::new_scalar(1.0/log(Interval(10.0)))) * log(nl2expr (e -> L.e)));
-	case OP_cos:   return cos( nl2expr(e -> L.e));
-	case OP_sin:   return sin( nl2expr(e -> L.e));
-	case OP_tan:   return tan( nl2expr(e -> L.e));
-	case OP_cosh:  return cosh(nl2expr(e -> L.e));
-	case OP_sinh:  return sinh(nl2expr(e -> L.e));
-	case OP_tanh:  return tanh(nl2expr(e -> L.e));
-	case OP_acos:  return acos(nl2expr(e -> L.e));
-	case OP_asin:  return asin(nl2expr(e -> L.e));
-	case OP_atan:  return atan(nl2expr(e -> L.e));
-	case OP_asinh: return asinh(nl2expr(e -> L.e));
-	case OP_acosh: return acosh(nl2expr(e -> L.e));
-	case OP_atanh: return atanh(nl2expr(e -> L.e));
-	case OP_atan2: return atan2(nl2expr(e -> L.e), nl2expr(e -> R.e));
-	//case OPintDIV: notimpl ("intdiv");
-	//case OPprecision: notimpl ("precision");
-	//case OPround:  notimpl ("round");
-	//case OPtrunc:  notimpl ("trunc");
-	case FLOOR:   return floor(nl2expr(e -> L.e));
-	case CEIL:    return ceil(nl2expr(e -> L.e));
-	//case OPFUNCALL: notimpl ("function call");
-	//case OPPLTERM:  notimpl ("plterm");
-	//case OPIFSYM:   notimpl ("ifsym");
-	//case OPHOL:     notimpl ("hol");
-	//case OPREM:   notimpl ("remainder");
-	//case OPLESS:  notimpl ("less");
-	//case OPIFnl:  // TODO return (chi(nl2expr(????))) perhaps need BoolInterval??
-	                // see ASL/solvers/rops.c, see f_OPIFnl and  expr_if
-	case OPVARVAL:  {
-		int j = ((expr_v *) e) -> a;
-		if (j<n_var) {
-			return (*(_x[j]));
+}
+
+namespace {
+
+// root of the set of i (union-find, with path halving)
+int find_root(std::vector<int>& parent, int i) {
+	while (parent[i]!=i) {
+		parent[i] = parent[parent[i]];
+		i = parent[i];
+	}
+	return i;
+}
+
+// merges the sets of i and j
+void unite(std::vector<int>& parent, int i, int j) {
+	i = find_root(parent, i);
+	j = find_root(parent, j);
+	if (i!=j) parent[std::max(i,j)] = std::min(i,j);
+}
+
+// the symbols of the expression e (each node being visited once)
+void symbols(const ExprNode& e, std::vector<const ExprSymbol*>& syms) {
+	std::set<const ExprNode*> visited;
+	std::vector<const ExprNode*> stack(1, &e);
+	while (!stack.empty()) {
+		const ExprNode* n = stack.back();
+		stack.pop_back();
+		if (!visited.insert(n).second) continue;
+		if (const ExprSymbol* x = dynamic_cast<const ExprSymbol*>(n))
+			syms.push_back(x);
+		else if (const ExprIndex* f = dynamic_cast<const ExprIndex*>(n))
+			stack.push_back(&f->expr);
+		else if (const ExprUnaryOp* f = dynamic_cast<const ExprUnaryOp*>(n))
+			stack.push_back(&f->expr);
+		else if (const ExprBinaryOp* f = dynamic_cast<const ExprBinaryOp*>(n)) {
+			stack.push_back(&f->left);
+			stack.push_back(&f->right);
+		} else if (const ExprNAryOp* f = dynamic_cast<const ExprNAryOp*>(n)) {
+			for (int i=0; i<f->nb_args; i++)
+				stack.push_back(&f->arg(i));
 		}
-		else {
-			// http://www.gerad.ca/~orban/drampl/def-vars.html
-			// common expression | defined variable
-			int k = (expr_v *)e - VAR_E;
-			double coeff;
-			int index;
-
-			if( k >= n_var ) {
-				const ExprNode* body;
-				// This is a common expression. Find pointer to its root.
-
-				// Check if the common expression are already construct
-				if (var_data.find(k)!=var_data.end()) {
-					body = var_data[k];
-				}
-				else {
-					// Constract the common expression
-					j = k - n_var;
-					if( j < ncom0 ) 	{
-						cexp *common = CEXPS +j;
-						// init with the nonlinear part
-						body = &(nl2expr(common->e));
-
-						int nlin = common->nlin; // Number of linear terms
-						if( nlin > 0 ) {
-							linpart * L = common->L;
-							for(int i = 0; i < nlin; i++ ) {
-								if ((dynamic_cast<const ExprConstant*>(body))&&(((ExprConstant*)(body))->is_zero())) {
-									coeff = (L[i]).fac;
-									index = ((uintptr_t) (L[i].v.rp) - (uintptr_t) VAR_E) / sizeof (expr_v);
-									if (coeff==1) {
-										body = &((*(_x[index])));
-									} else if (coeff==-1) {
-										body = &( - (*(_x[index])));
-									} else if (coeff != 0) {
-										body = &(coeff * (*(_x[index])));
-									}
-								}
-								else {
-									coeff = (L[i]).fac;
-									index = ((uintptr_t) (L[i].v.rp) - (uintptr_t) VAR_E) / sizeof (expr_v);
-									if (coeff==1) {
-										body = &(*body + (*(_x[index])));
-									} else if (coeff==-1) {
-										body = &(*body - (*(_x[index])));
-									} else if (coeff != 0) {
-										body = &(*body +coeff * (*(_x[index])));
-									}
-								}
-							}
-						}
-					}
-					else {
-						cexp1 *common = (CEXPS1 - ncom0) +j ;
-						// init with the nonlinear part
-						body = &(nl2expr(common->e));
-
-						int nlin = common->nlin; // Number of linear terms
-						if( nlin > 0 ) {
-							linpart * L = common->L;
-							for(int i = 0; i < nlin; i++ ) {
-								if ((dynamic_cast<const ExprConstant*>(body))&&(((ExprConstant*)(body))->is_zero())) {
-									coeff = (L[i]).fac;
-									index = ((uintptr_t) (L[i].v.rp) - (uintptr_t) VAR_E) / sizeof (expr_v);
-									if (coeff==1) {
-										body = &( (*(_x[index])));
-									} else if (coeff==-1) {
-										body = &( - (*(_x[index])));
-									} else if (coeff != 0) {
-										body = &(coeff * (*(_x[index])));
-									}
-								}
-								else {
-									coeff = (L[i]).fac;
-									index = ((uintptr_t) (L[i].v.rp) - (uintptr_t) VAR_E) / sizeof (expr_v);
-									if (coeff==1) {
-										body = &(*body + (*(_x[index])));
-									} else if (coeff==-1) {
-										body = &(*body - (*(_x[index])));
-									} else if (coeff != 0) {
-										body = &(*body +coeff * (*(_x[index])));
-									}
-
-								}
-							}
-						}
-					}
-					// Store the temporary variable, in case of reuse it late, to construct a DAG (and not just a tree.
-					var_data[k] = body;;
-				}
-				return *body;
+	}
+}
 
-			}
-			else {
-				ibex_error("Error AmplInterface: unknown defined variable \n");
-				throw -1;
-			}
+// the terms coef*t of an expression coef*e, e being split through the sums,
+// subtractions, opposites, products by a constant and dot products with a
+// constant vector (see #linear_sum())
+void split_terms(const ExprNode& e, const Interval& coef, std::vector<std::pair<const ExprNode*,Interval> >& terms) {
+	if (const ExprAdd* f = dynamic_cast<const ExprAdd*>(&e)) {
+		split_terms(f->left, coef, terms);
+		split_terms(f->right, coef, terms);
+	} else if (const ExprSub* f = dynamic_cast<const ExprSub*>(&e)) {
+		split_terms(f->left, coef, terms);
+		split_terms(f->right, -coef, terms);
+	} else if (const ExprMinus* f = dynamic_cast<const ExprMinus*>(&e)) {
+		split_terms(f->expr, -coef, terms);
+	} else if (const ExprMul* f = dynamic_cast<const ExprMul*>(&e)) {
+		const ExprConstant* c = dynamic_cast<const ExprConstant*>(&f->left);
+		const ExprVector* v = dynamic_cast<const ExprVector*>(&f->right);
+		if (c && c->dim.is_scalar())
+			split_terms(f->right, coef*c->get_value(), terms);
+		else if (c && v && c->dim.is_vector() && c->dim.vec_size()==v->nb_args) {
+			for (int i=0; i<v->nb_args; i++)
+				split_terms(v->arg(i), coef*c->get_vector_value()[i], terms);
+		} else
+			terms.push_back(std::make_pair(&e, coef));
+	} else
+		terms.push_back(std::make_pair(&e, coef));
+}
+
+}
+
+// The connected components of the graph of the variables and constraints
+// of the system (see #set_decompose()), from the Jacobian structure of the
+// constraints and the additive terms of the objective (its linear terms
+// being separable). The components are numbered in the order of their
+// first variable.
+void AmplInterface::find_components(const ExprNode* obj_body) {
+	int n = 0;
+	for (int j = 0; j < n_var; j++)
+		if (var_index[j]>=0) n++;
+	var_comp.assign(n+_aux.size(), 0);
+	nb_components = 1;
+
+	if (decompose!=1 || lazy || !_aux.empty() || n==0) return;
+
+	std::vector<int> parent(n);
+	for (int v = 0; v < n; v++)
+		parent[v] = v;
+
+	// the constraints added to the system
+	for (size_t c = 0; c < ctr_rows.size(); c++) {
+		int i = ctr_rows[c];
+		int first = -1;
+		for (int k = row_start[i]; k < row_start[i+1]; k++) {
+			int v = var_index[row_var[k]];
+			if (v<0) continue;
+			if (first<0) first = v;
+			else unite(parent, first, v);
 		}
 	}
 
-	default: {
-		std::cout << opmap[Intcast (e -> op)] << std::endl;
-		ibex_error( "Error AmplInterface: unknown operator or not implemented \n " );
-		throw -2;
+	// the nonlinear terms of the objective
+	if (obj_body) {
+		std::map<const ExprSymbol*,int> index;
+		for (int j = 0; j < n_var; j++)
+			if (var_index[j]>=0) index[_x[j]] = var_index[j];
+
+		std::vector<std::pair<const ExprNode*,Interval> > terms;
+		split_terms(*obj_body, Interval(1), terms);
+		std::vector<const ExprSymbol*> syms;
+		for (size_t t = 0; t < terms.size(); t++) {
+			syms.clear();
+			symbols(*terms[t].first, syms);
+			for (size_t k = 1; k < syms.size(); k++)
+				unite(parent, index[syms[0]], index[syms[k]]);
+		}
 	}
+
+	// the roots are the first variables of their components
+	nb_components = 0;
+	for (int v = 0; v < n; v++) {
+		int r = find_root(parent, v);
+		var_comp[v] = (r==v) ? nb_components++ : var_comp[r];
+	}
+}
+
+namespace {
+
+// Depth-first search of an augmenting path from the equation e0 in the
+// bipartite graph adj (equation -> variables). The variables reached are
+// marked with stamp in seen. Returns true if the matching is augmented.
+bool augment(int e0, const std::vector<std::vector<int> >& adj, std::vector<int>& match_var,
+		std::vector<int>& match_eq, std::vector<int>& seen, int stamp) {
+	std::vector<std::pair<int,size_t> > stack(1, std::make_pair(e0, (size_t) 0));
+	std::vector<int> path; // the variable chosen at each level of the stack
+	while (!stack.empty()) {
+		int e = stack.back().first;
+		if (stack.back().second == adj[e].size()) {
+			stack.pop_back();
+			if (!path.empty()) path.pop_back();
+			continue;
+		}
+		int v = adj[e][stack.back().second++];
+		if (seen[v]==stamp) continue;
+		seen[v] = stamp;
+		path.push_back(v);
+		if (match_var[v] < 0) {
+			for (size_t i = 0; i < stack.size(); i++) {
+				match_var[path[i]] = stack[i].first;
+				match_eq[stack[i].first] = path[i];
+			}
+			return true;
+		}
+		stack.push_back(std::make_pair(match_var[v], (size_t) 0));
 	}
-	return ExprConstant::new_scalar(0.);
+	return false;
+}
+
 }
 
+// The block-triangular decomposition of the equations of the system
+// (see #set_blocks()): a maximum matching between the equations and their
+// variables (Jacobian structure) is computed by augmenting paths, then the
+// strongly connected components of the graph where an equation depends on
+// the equations matched with its other variables (Tarjan). The components
+// are found after the ones they depend on, i.e., in the order of resolution.
+void AmplInterface::find_blocks() {
+	block_ctrs.clear();
+	block_vars.clear();
+	if (blocks!=1 || lazy || !_aux.empty()) return;
+
+	// the equations (system constraints) and their variables
+	std::vector<int> eqs;
+	std::vector<std::vector<int> > adj;
+	int n = 0;
+	for (int j = 0; j < n_var; j++)
+		if (var_index[j]>=0) n++;
+	std::vector<int> seen(n, -1);
+	for (size_t c = 0; c < ctr_rows.size(); c++) {
+		int i = ctr_rows[c];
+		Interval rhs = row_rhs.empty() ? get_ctr_bounds(i) : row_rhs[i];
+		if (rhs.lb()!=rhs.ub()) continue;
+		std::vector<int> vars;
+		for (int k = row_start[i]; k < row_start[i+1]; k++) {
+			int v = var_index[row_var[k]];
+			if (v>=0 && seen[v]!=(int) c) {
+				seen[v] = c;
+				vars.push_back(v);
+			}
+		}
+		eqs.push_back(c);
+		adj.push_back(vars);
+	}
+	int m = eqs.size();
+
+	// maximum matching
+	std::vector<int> match_var(n, -1), match_eq(m, -1);
+	seen.assign(n, -1);
+	for (int e = 0; e < m; e++)
+		augment(e, adj, match_var, match_eq, seen, e);
+
+	// strongly connected components of the matched equations
+	std::vector<int> index(m, -1), low(m, 0);
+	std::vector<bool> on_stack(m, false);
+	std::vector<int> scc;
+	std::vector<std::pair<int,size_t> > calls;
+	int counter = 0;
+	for (int e0 = 0; e0 < m; e0++) {
+		if (index[e0]>=0 || match_eq[e0]<0) continue;
+		calls.push_back(std::make_pair(e0, (size_t) 0));
+		index[e0] = low[e0] = counter++;
+		scc.push_back(e0);
+		on_stack[e0] = true;
+		while (!calls.empty()) {
+			int u = calls.back().first;
+			if (calls.back().second < adj[u].size()) {
+				int w = match_var[adj[u][calls.back().second++]];
+				if (w<0 || w==u) continue;
+				if (index[w]<0) {
+					index[w] = low[w] = counter++;
+					scc.push_back(w);
+					on_stack[w] = true;
+					calls.push_back(std::make_pair(w, (size_t) 0));
+				} else if (on_stack[w])
+					low[u] = std::min(low[u], index[w]);
+				continue;
+			}
+			calls.pop_back();
+			if (!calls.empty())
+				low[calls.back().first] = std::min(low[calls.back().first], low[u]);
+			if (low[u]==index[u]) {
+				std::vector<int> ctrs, vars;
+				int w;
+				do {
+					w = scc.back();
+					scc.pop_back();
+					on_stack[w] = false;
+					ctrs.push_back(eqs[w]);
+				} while (w!=u);
+				std::sort(ctrs.begin(), ctrs.end());
+				for (size_t k = 0; k < ctrs.size(); k++)
+					vars.push_back(match_eq[std::lower_bound(eqs.begin(), eqs.end(), ctrs[k])-eqs.begin()]);
+				block_ctrs.push_back(ctrs);
+				block_vars.push_back(vars);
+			}
+		}
+	}
+}
+
+// The component of an expression e of a function of the variables x
+// (the i-th being the i-th variable of the system): -1 if e is constant,
+// -2 if its variables are in several components.
+int AmplInterface::expr_component(const ExprNode& e, const std::map<const ExprSymbol*,int>& x) const {
+	std::vector<const ExprSymbol*> syms;
+	symbols(e, syms);
+	int comp = -1;
+	for (size_t k = 0; k < syms.size(); k++) {
+		int c = var_comp[x.find(syms[k])->second];
+		if (comp>=0 && c!=comp) return -2;
+		comp = c;
+	}
+	return comp;
+}
+
+// The component of the c-th constraint of sys (see expr_component()).
+int AmplInterface::ctr_component(const System& sys, int c) const {
+	const Function& f = sys.ctrs[c].f;
+	std::map<const ExprSymbol*,int> x;
+	for (int i = 0; i < sys.nb_var; i++)
+		x[&f.arg(i)] = i;
+	return expr_component(f.expr(), x);
+}
+
+std::vector<int> AmplInterface::get_component_vars(int k) const {
+	std::vector<int> vars;
+	for (size_t i = 0; i < var_comp.size(); i++)
+		if (var_comp[i]==k) vars.push_back(i);
+	return vars;
+}
+
+std::vector<int> AmplInterface::get_component_ctrs(const System& sys, int k) const {
+	// (the constant constraints are in the first component)
+	std::vector<int> ctrs;
+	for (int c = 0; c < sys.nb_ctr; c++) {
+		int comp = ctr_component(sys, c);
+		if (comp==k || (comp==-1 && k==0)) ctrs.push_back(c);
+	}
+	return ctrs;
+}
+
+System* AmplInterface::get_component_system(const System& sys, int k) const {
+	if (k<0 || k>=nb_components) {
+		ibex_error("Error AmplInterface: component index out of range\n");
+	}
+
+	// the variables of the component (the other ones are mapped to
+	// placeholders that cannot appear in the copies)
+	std::vector<int> vars = get_component_vars(k);
+
+	Array<const ExprSymbol> y(vars.size());
+	Array<const ExprNode> new_x(sys.nb_var);
+	std::vector<const ExprNode*> placeholders;
+	for (int i = 0, j = 0; i < sys.nb_var; i++) {
+		if (var_comp[i]==k) {
+			y.set_ref(j, ExprSymbol::new_(sys.args[i].name, Dim::scalar()));
+			new_x.set_ref(i, y[j++]);
+		} else {
+			placeholders.push_back(&ExprConstant::new_scalar(0));
+			new_x.set_ref(i, *placeholders.back());
+		}
+	}
+
+	System* res = NULL;
+	{
+		SystemFactory fac;
+		for (size_t j = 0; j < vars.size(); j++)
+			fac.add_var(y[j], sys.box[vars[j]]);
+
+		bool separable = true;
+
+		// the terms of the objective in the component (the constant terms in the first one)
+		if (sys.goal) {
+			std::map<const ExprSymbol*,int> x;
+			for (int i = 0; i < sys.nb_var; i++)
+				x[&sys.goal->arg(i)] = i;
+
+			std::vector<std::pair<const ExprNode*,Interval> > terms;
+			split_terms(sys.goal->expr(), Interval(1), terms);
+			const ExprNode* goal = NULL;
+			for (size_t t = 0; separable && t < terms.size(); t++) {
+				int c = expr_component(*terms[t].first, x);
+				if (c==-2) separable = false;
+				if (c!=k && !(c==-1 && k==0)) continue;
+				const ExprNode& e = ExprCopy().copy(sys.goal->args(), new_x, *terms[t].first);
+				const Interval& coef = terms[t].second;
+				const ExprNode& term = coef==Interval(1) ? e : (coef==Interval(-1) ? -e : ExprConstant::new_scalar(coef)*e);
+				goal = goal ? &(*goal + term) : &term;
+			}
+			if (separable)
+				fac.add_goal(goal ? *goal : ExprConstant::new_scalar(0));
+			else if (goal)
+				cleanup(*goal, false);
+		}
+
+		// the constraints of the component (the constant ones in the first one)
+		for (int c = 0; separable && c < sys.nb_ctr; c++) {
+			const Function& f = sys.ctrs[c].f;
+			int comp = ctr_component(sys, c);
+			if (comp==-2) separable = false;
+			if (comp!=k && !(comp==-1 && k==0)) continue;
+			fac.add_ctr(ExprCtr(ExprCopy().copy(f.args(), new_x, f.expr()), sys.ctrs[c].op));
+		}
+
+		if (separable) res = new System(fac);
+	}
+
+	for (size_t j = 0; j < placeholders.size(); j++)
+		delete placeholders[j];
+	for (int j = 0; j < y.size(); j++)
+		delete &y[j];
+	return res;
+}
+
+// Adds the i-th constraint, f being its expression (without bounds).
+bool AmplInterface::add_row(int i, const ExprNode& f) {
+	const ExprNode& body = simplified(f);
+	int sig;
+	double lb, ub;
+
+	/* LUrhs is the constraint lower bound if Urhsx!=0, and the constraint lower and upper bound if Uvx == 0 */
+	if (!row_rhs.empty()) {          // merged with its parallel constraints (see merge_rows())
+		lb = row_rhs[i].lb();
+		ub = row_rhs[i].ub();
+	} else if (Urhsx) {
+		lb = LUrhs [i];
+		ub = Urhsx [i];
+	} else {
+		lb = LUrhs [2*i];
+		ub = LUrhs [2*i+1];
+	}
+
+	// set constraint sign
+	if (negInfinity < lb)
+		if (ub < Infinity)  sig =1; // EQ;
+		else                sig =2; // GEQ;
+	else                    sig =3; // LEQ;
+
+	// add them (and set lower-upper bound)
+	ctr_rows.push_back(i);
+	switch (sig) {
+
+	case  1:  {
+		if (lb==ub) {
+			if (lb==0) {
+				add_ctr_eq(body);
+			} else if (lb<0) {
+				add_ctr_eq(body+(-lb));
+			} else {
+				add_ctr_eq(body-lb);
+			}
+		} else  {
+			 std::string name1 = "_1";
+			 name1 = con_name(i)+name1;
+			 std::string name2 = "_2";
+			 name2 = con_name(i)+name2;
+			 add_ctr(ExprCtr(body-ub, LEQ), name1.c_str());
+			 add_ctr(ExprCtr(body-lb, GEQ), name2.c_str());
+			 ctr_rows.push_back(i);
+		}
+		break;
+	}
+	case  2:  {
+		if (lb==0) {
+			add_ctr(ExprCtr(body,GEQ),con_name(i));
+		} else if (lb<0) {
+			add_ctr(ExprCtr(body+(-lb),GEQ),con_name(i));
+		} else {
+			add_ctr(ExprCtr(body-lb,GEQ),con_name(i));
+		}
+		break;
+	}
+	case  3: {
+		if (ub==0) {
+			add_ctr(ExprCtr(body,LEQ),con_name(i));
+		} else if (ub<0) {
+			add_ctr(ExprCtr(body+(-ub),LEQ),con_name(i));
+		} else {
+			add_ctr(ExprCtr(body-ub,LEQ),con_name(i));
+		}
+		break;
+	}
+	default: ibex_error("Error: could not recognize a constraint\n"); return false;
+	}
+	return true;
+}
+
+namespace {
+
+// Maximal size of the expressions simplified at levels 3, 2 and 1 in the
+// adaptive mode: the more advanced simplifications (that may blow up)
+// are only tried on small expressions.
+const int SIMPL3_MAX_SIZE = 30;
+const int SIMPL2_MAX_SIZE = 1000;
+const int SIMPL1_MAX_SIZE = 100000;
+
+// Part of the budget beyond which a simplification is too expensive:
+// the level is not tried anymore on the next expressions.
+const double SIMPL_MAX_SHARE = 0.1;
+
+int adaptive_level(int size) {
+	if (size<=SIMPL3_MAX_SIZE) return 3;
+	else if (size<=SIMPL2_MAX_SIZE) return 2;
+	else if (size<=SIMPL1_MAX_SIZE) return 1;
+	else return 0;
+}
+
+// Adds the nodes of e (except the symbols) to a set.
+void insert_nodes(const ExprNode& e, std::set<const ExprNode*>& nodes) {
+	ExprSubNodes sub(e);
+	for (int i=0; i<sub.size(); i++)
+		if (!dynamic_cast<const ExprSymbol*>(&sub[i]))
+			nodes.insert(&sub[i]);
+}
+
+}
+
+// The expression given to the system in place of e (a constraint or the goal).
+//
+// In the adaptive mode (simpl_budget>0), this is a simplified copy of e,
+// with a level chosen according to the size of e and to the time left:
+// once the budget is spent (or at level 0), e itself is returned. A result
+// larger than e (blow-up of the polynomial developing) is discarded and
+// the expression is simplified again at a lower level, while the budget
+// is not spent (e is returned otherwise). The original expression, whose
+// nodes may be shared with other constraints, is not modified: its nodes
+// are deleted with the interface, except the ones shared with an
+// expression returned as is.
+//
+// Note: the time is only checked between two calls to simplify(), that
+// cannot be interrupted. The size limits of the levels (see adaptive_level)
+// are what bounds the time of a single call.
+const ExprNode& AmplInterface::simplified(const ExprNode& e) {
+	if (simpl_budget<=0) return e;
+
+	int level = simpl_time < simpl_budget ? std::min(adaptive_level(e.size), simpl_max_level) : 0;
+	if (level==0) {
+		insert_nodes(e, simpl_kept);
+		simpl_count[0]++;
+		return e;
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	const ExprNode* res = &ExprCopy().copy(*simpl_symbols, *simpl_symbols, e).simplify(level);
+	int tried = level;
+
+	while (level>1 && res->size > e.size) {
+		cleanup(*res, false);
+		double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (simpl_time + t >= simpl_budget) {
+			level = 0;
+			res = &e;
+		} else {
+			tried = --level;
+			res = &ExprCopy().copy(*simpl_symbols, *simpl_symbols, e).simplify(level);
+		}
+	}
+
+	double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	simpl_time += t;
+	if (t > SIMPL_MAX_SHARE*simpl_budget)
+		simpl_max_level = tried-1;
+
+	insert_nodes(e, res==&e ? simpl_kept : simpl_originals);
+	simpl_count[level]++;
+	return *res;
+}
+
+namespace {
+
+// Sum of the terms t[lo..hi[ (the ones with neg[i]=true being subtracted),
+// built as a balanced binary tree so that its height is O(log(hi-lo)).
+// The left half gets the extra term, so that sums of up to 3 terms
+// coincide with the left-deep sums ((t0+t1)+t2).
+const ExprNode& balanced_sum(const std::vector<const ExprNode*>& t, const std::vector<bool>& neg, size_t lo, size_t hi) {
+	if (hi-lo==1) {
+		if (neg[lo])
+			return -(*t[lo]);
+		else
+			return *t[lo];
+	}
+
+	size_t mid = lo + (hi-lo+1)/2;
+	const ExprNode& left = balanced_sum(t, neg, lo, mid);
+	if (hi-mid==1 && neg[mid])
+		return left - *t[mid];
+	else
+		return left + balanced_sum(t, neg, mid, hi);
+}
+
+}
+
+namespace {
+
+// An AMPL operator: the address of its evaluation function and its opcode.
+struct op_entry {
+	size_t f;
+	int op;
+	bool operator<(const op_entry& x) const { return f<x.f; }
+};
+
+// The AMPL operators sorted by address of their evaluation function.
+// When several opcodes share the same function, the last one is kept.
+std::vector<op_entry> make_op_table() {
+	std::vector<op_entry> t;
+	for (int i=0; i<N_OPS; i++) {
+		op_entry x = { Intcast (r_ops[i]), i };
+		t.push_back(x);
+	}
+	std::stable_sort(t.begin(), t.end());
+
+	size_t k=0;
+	for (size_t i=0; i<t.size(); i++) {
+		if (k>0 && t[k-1].f==t[i].f)
+			t[k-1] = t[i];
+		else
+			t[k++] = t[i];
+	}
+	t.resize(k);
+	return t;
+}
+
+// Built once, shared by all the instances (read-only).
+const std::vector<op_entry>& op_table() {
+	static const std::vector<op_entry> table = make_op_table();
+	return table;
+}
+
+}
+
+// the opcode of an AMPL node, by binary search in the operator table
+int AmplInterface::opcode(const expr* e) {
+	const std::vector<op_entry>& t = op_table();
+	op_entry x = { Intcast (e -> op), -1 };
+	std::vector<op_entry>::const_iterator it = std::lower_bound(t.begin(), t.end(), x);
+	if (it!=t.end() && it->f==x.f)
+		return it->op;
+	else
+		return -1;
+}
+
+// true if the AMPL expression is the constant 0 (no nonlinear part)
+bool AmplInterface::is_null(expr *e) {
+	return opcode(e)==OPNUM && ((expr_n *)e)->v==0;
+}
+
+// the sum of a nonlinear part (NULL if none) and the linear terms coef[i]*x[var[i]]
+const ExprNode& AmplInterface::linear_sum(const ExprNode* body, int n, const int* var, const double* coef) {
+
+	int nlin = 0;          // number of nonzero linear terms (on variables that are not fixed)
+	Interval cst(0);       // sum of the terms on fixed variables
+	for (int i = 0; i < n; i++) {
+		if (coef[i] == 0) continue;
+		if (var_index[var[i]] < 0)
+			cst += coef[i] * Interval(var_value[var[i]]);
+		else
+			nlin++;
+	}
+
+	if (linear_form && nlin > 1) {
+		// the linear terms as a single dot product: coefficients (row vector) * variables (column vector)
+		IntervalVector c(nlin);
+		Array<const ExprNode> v(nlin);
+		for (int i = 0, k = 0; i < n; i++) {
+			if (coef[i] != 0 && var_index[var[i]] >= 0) {
+				c[k] = coef[i];
+				v.set_ref(k++, *(_x[var[i]]));
+			}
+		}
+		const ExprNode* res = &(ExprConstant::new_vector(c, true) * ExprVector::new_col(v));
+		if (body)
+			res = &(*body + *res);
+		if (!cst.is_zero())
+			res = &(*res + ExprConstant::new_scalar(cst));
+		return *res;
+	}
+
+	sum_terms.clear();
+	sum_neg.clear();
+
+	if (body) {
+		sum_terms.push_back(body);
+		sum_neg.push_back(false);
+	}
+
+	for (int i = 0; i < n; i++) {
+		double coeff = coef[i];
+		if (var_index[var[i]] < 0) {
+			continue; // in cst
+		} else if (coeff==1) {
+			sum_terms.push_back(_x[var[i]]);
+			sum_neg.push_back(false);
+		} else if (coeff==-1) {
+			sum_terms.push_back(_x[var[i]]);
+			sum_neg.push_back(true);
+		} else if (coeff != 0) {
+			sum_terms.push_back(&(coeff * (*(_x[var[i]]))));
+			sum_neg.push_back(false);
+		}
+	}
+
+	if (!cst.is_zero()) {
+		sum_terms.push_back(&ExprConstant::new_scalar(cst));
+		sum_neg.push_back(false);
+	}
+
+	if (sum_terms.empty())
+		return ExprConstant::new_scalar(0.);
+
+	return balanced_sum(sum_terms, sum_neg, 0, sum_terms.size());
+}
+
+// the common expression (defined variable) k, from the translation of its nonlinear part (NULL if none)
+const ExprNode* AmplInterface::add_linpart(int k, const ExprNode* body) {
+	int j = k - n_var;
+	int nlin;
+	linpart* L;
+	if (j < ncom0) {
+		cexp *common = CEXPS +j;
+		nlin = common->nlin;
+		L = common->L;
+	} else {
+		cexp1 *common = (CEXPS1 - ncom0) +j ;
+		nlin = common->nlin;
+		L = common->L;
+	}
+
+	lin_var.clear();
+	lin_coef.clear();
+	for(int i = 0; i < nlin; i++ ) {
+		lin_var.push_back(((uintptr_t) (L[i].v.rp) - (uintptr_t) VAR_E) / sizeof (expr_v));
+		lin_coef.push_back((L[i]).fac);
+	}
+	const ExprNode* res = &(linear_sum(body, nlin, lin_var.data(), lin_coef.data()));
+
+	// Store the temporary variable, in case of reuse it late, to construct a DAG (and not just a tree.
+	var_data[j] = res;
+	return res;
+}
+
+// the expression of the common expression (defined variable) k, translated if needed
+const ExprNode& AmplInterface::defined_var(int k) {
+	int j = k - n_var;
+	if (var_data[j])
+		return *var_data[j];
+
+	expr* ce = (j < ncom0) ? (CEXPS+j)->e : ((CEXPS1 - ncom0)+j)->e;
+	return *add_linpart(k, is_null(ce) ? NULL : &nl2expr(ce));
+}
+
+// the node op(t[0],...,t[n-1]) if it has already been built, NULL otherwise,
+// cst being the constant of the operator (exponent, base or number)
+const ExprNode* AmplInterface::find_node(int op, const Term* t, size_t n, double cst) {
+	nb_nodes++;
+	const ExprNode* e = node_table.find(op, cst, t, n);
+	if (e) nb_shared_nodes++;
+	return e;
+}
+
+// a number (its node is only built if needed)
+AmplInterface::Term AmplInterface::number(const Interval& v) {
+	Term t;
+	t.e = NULL;
+	t.neg = false;
+	t.v = v;
+	return t;
+}
+
+// the j-th variable of the model (its value if it is fixed)
+AmplInterface::Term AmplInterface::variable(int j) {
+	if (var_index[j] < 0)
+		return number(var_value[j]);
+	else
+		return term(_x[j]);
+}
+
+// an expression already translated
+AmplInterface::Term AmplInterface::term(const ExprNode* e) {
+	Term t;
+	t.e = e;
+	t.neg = false;
+	t.v = Interval::zero();
+	return t;
+}
+
+// the node of a term (the constant and the negation are built here)
+const ExprNode& AmplInterface::node(Term& t) {
+	if (!t.e && !t.v.is_degenerated()) {
+		// a folded constant (not shared)
+		t.e = &ExprConstant::new_scalar(t.v);
+	} else if (!t.e) {
+		t.e = find_node(OPNUM, NULL, 0, t.v.lb());
+		if (!t.e) {
+			t.e = &ExprConstant::new_scalar(t.v);
+			node_table.insert(OPNUM, t.v.lb(), (const Term*) NULL, 0, t.e);
+		}
+	}
+	if (t.neg) {
+		Term u = term(t.e);
+		t.e = make_node(OPUMINUS, &u, 1, 0);
+		t.neg = false;
+	}
+	return *t.e;
+}
+
+namespace {
+
+// Computes in r an enclosure of op(x[0],...,x[n-1]), cst being the exponent (OP1POW)
+// or the base (OPCPOW). Returns false if the operator is not folded or if the
+// result is empty (the operation is then kept, as in the model).
+bool fold(int op, const std::vector<Interval>& x, double cst, Interval& r) {
+	switch (op) {
+	case OPPLUS:   r = x[0] + x[1]; break;
+	case OPMINUS:  r = x[0] - x[1]; break;
+	case OPMULT:   r = x[0] * x[1]; break;
+	case OPDIV:    {
+		if (x[1].contains(0)) return false;
+		r = x[0] / x[1];
+		break;
+	}
+	case OPPOW:    r = pow(x[0], x[1]); break;
+	case OP1POW:   {
+		if (((int) cst)==cst)
+			r = pow(x[0], (int) cst);
+		else
+			r = pow(x[0], Interval(cst));
+		break;
+	}
+	case OP2POW:   r = sqr(x[0]); break;
+	case OPCPOW:   r = pow(Interval(cst), x[0]); break;
+	case OPSUMLIST: {
+		r = x[0];
+		for (size_t i=1; i<x.size(); i++)
+			r += x[i];
+		break;
+	}
+	case MINLIST:  {
+		r = x[0];
+		for (size_t i=1; i<x.size(); i++)
+			r = min(r, x[i]);
+		break;
+	}
+	case MAXLIST:  {
+		r = x[0];
+		for (size_t i=1; i<x.size(); i++)
+			r = max(r, x[i]);
+		break;
+	}
+	case ABS:      r = abs(x[0]); break;
+	case OPUMINUS: r = -x[0]; break;
+	case OP_sqrt:  r = sqrt(x[0]); break;
+	case OP_exp:   r = exp(x[0]); break;
+	case OP_log:   r = log(x[0]); break;
+	case OP_log10: r = (1.0/log(Interval(10.0))) * log(x[0]); break;
+	case OP_cos:   r = cos(x[0]); break;
+	case OP_sin:   r = sin(x[0]); break;
+	case OP_tan:   r = tan(x[0]); break;
+	case OP_cosh:  r = cosh(x[0]); break;
+	case OP_sinh:  r = sinh(x[0]); break;
+	case OP_tanh:  r = tanh(x[0]); break;
+	case OP_acos:  r = acos(x[0]); break;
+	case OP_asin:  r = asin(x[0]); break;
+	case OP_atan:  r = atan(x[0]); break;
+	case OP_asinh: r = asinh(x[0]); break;
+	case OP_acosh: r = acosh(x[0]); break;
+	case OP_atanh: r = atanh(x[0]); break;
+	case OP_atan2: r = atan2(x[0], x[1]); break;
+	case FLOOR:    r = floor(x[0]); break;
+	case CEIL:     r = ceil(x[0]); break;
+	default:       return false;
+	}
+	return !r.is_empty();
+}
+
+}
+
+// The term op(t[0],...,t[n-1]), cst being the exponent (OP1POW) or the base (OPCPOW).
+//
+// If all the operands are numbers, the operation is folded into a single constant,
+// the (correctly rounded) interval enclosing the exact result, whatever the
+// simplification level. A power with a constant exponent or a constant base is
+// specialized as in the ASL (see new_expr in fg_read.c).
+AmplInterface::Term AmplInterface::apply(int op, Term* t, size_t n, double cst) {
+	bool numbers = true;
+	for (size_t i=0; i<n && numbers; i++)
+		if (t[i].e) numbers = false;
+
+	if (numbers) {
+		fold_args.clear();
+		for (size_t i=0; i<n; i++)
+			fold_args.push_back(t[i].neg ? -t[i].v : t[i].v);
+		Interval r;
+		if (fold(op, fold_args, cst, r)) {
+			nb_folded++;
+			return number(r);
+		}
+	}
+
+	if (op==OPPOW) {
+		if (!t[1].e && !t[1].neg && t[1].v.is_degenerated()) {
+			if (t[1].v.lb()==2)
+				return term(make_node(OP2POW, t, 1, 0));
+			else
+				return term(make_node(OP1POW, t, 1, t[1].v.lb()));
+		} else if (!t[0].e && !t[0].neg && t[0].v.is_degenerated())
+			return term(make_node(OPCPOW, t+1, 1, t[0].v.lb()));
+	}
+
+	return term(make_node(op, t, n, cst));
+}
+
+// the opposite of a term (a number is negated at once)
+AmplInterface::Term AmplInterface::negate(const Term& t) {
+	Term res = t;
+	if (t.e)
+		res.neg = !t.neg;
+	else
+		res.v = -t.v;
+	return res;
+}
+
+// The node op(t[0],...,t[n-1]), cst being the exponent (OP1POW) or the base (OPCPOW),
+// unless an identical node has already been built.
+// The sign of an operand is absorbed by the additions and subtractions: a+(-b) is a-b,
+// a-(-b) is a+b. Otherwise, the negation is built.
+const ExprNode* AmplInterface::make_node(int op, Term* t, size_t n, double cst) {
+
+	for (size_t i=0; i<n; i++) {
+		bool absorbed = (op==OPPLUS && !t[1-i].neg) || ((op==OPMINUS || op==OPSUMLIST) && i>0);
+		if (t[i].neg && !absorbed)
+			node(t[i]);
+		else if (!t[i].e) {
+			bool neg = t[i].neg;
+			t[i].neg = false;
+			node(t[i]);
+			t[i].neg = neg;
+		}
+	}
+
+	const ExprNode* res = find_node(op, t, n, cst);
+	if (res) return res;
+
+	switch (op) {
+
+	case OPPLUS:   {
+		if (t[1].neg)
+			res = &(*t[0].e - *t[1].e);
+		else if (t[0].neg)
+			res = &(*t[1].e - *t[0].e);
+		else
+			res = &(*t[1].e + *t[0].e); // (right operand first, as the original translator)
+		break;
+	}
+	case OPMINUS:  {
+		if (t[1].neg)
+			res = &(*t[0].e + *t[1].e);
+		else
+			res = &(*t[0].e - *t[1].e);
+		break;
+	}
+	case OPDIV:    res = &(*t[0].e / *t[1].e); break;
+	case OPMULT:   res = &(operator*(*t[0].e, *t[1].e)); break;
+	case OPPOW:    res = &pow(*t[0].e, *t[1].e); break;
+	case OP1POW:   {
+		if (((int) cst)==cst) {
+			res = &pow(*t[0].e, (int) cst);
+		} else
+			res = &pow(*t[0].e, ExprConstant::new_scalar(cst));
+		break;
+	}
+	case OP2POW:   res = &sqr(*t[0].e); break;
+	case OPCPOW:   res = &pow(ExprConstant::new_scalar(cst), *t[0].e); break;
+	case MINLIST: {
+		res = t[0].e;
+		for (size_t i=1; i<n; i++)
+			res = &(min(*res, *t[i].e));
+		break;
+	}
+	case MAXLIST:  {
+		res = t[0].e;
+		for (size_t i=1; i<n; i++)
+			res = &(max(*res, *t[i].e));
+		break;
+	}
+	case OPSUMLIST: {
+		sum_terms.clear();
+		sum_neg.clear();
+		for (size_t i=0; i<n; i++) {
+			sum_terms.push_back(t[i].e);
+			sum_neg.push_back(t[i].neg);
+		}
+		res = &balanced_sum(sum_terms, sum_neg, 0, n);
+		break;
+	}
+	case ABS:      res = &abs(*t[0].e); break;
+	case OPUMINUS: res = &(operator-(*t[0].e)); break;
+	case OP_sqrt:  res = &sqrt(*t[0].e); break;
+	case OP_exp:   res = &exp(*t[0].e); break;
+	case OP_log:   res = &log(*t[0].e); break;
+	case OP_log10: res = &((ExprConstant::new_scalar(1.0/log(Interval(10.0)))) * log(*t[0].e)); break;
+	case OP_cos:   res = &cos(*t[0].e); break;
+	case OP_sin:   res = &sin(*t[0].e); break;
+	case OP_tan:   res = &tan(*t[0].e); break;
+	case OP_cosh:  res = &cosh(*t[0].e); break;
+	case OP_sinh:  res = &sinh(*t[0].e); break;
+	case OP_tanh:  res = &tanh(*t[0].e); break;
+	case OP_acos:  res = &acos(*t[0].e); break;
+	case OP_asin:  res = &asin(*t[0].e); break;
+	case OP_atan:  res = &atan(*t[0].e); break;
+	case OP_asinh: res = &asinh(*t[0].e); break;
+	case OP_acosh: res = &acosh(*t[0].e); break;
+	case OP_atanh: res = &atanh(*t[0].e); break;
+	case OP_atan2: res = &atan2(*t[0].e, *t[1].e); break;
+	case FLOOR:    res = &floor(*t[0].e); break;
+	case CEIL:     res = &ceil(*t[0].e); break;
+	default: {
+		std::stringstream msg;
+		msg << "Error AmplInterface: unknown operator or not implemented (opcode " << op << ")\n";
+		ibex_error(msg.str().c_str());
+		throw -2;
+	}
+	}
+
+	node_table.insert(op, cst, t, n, res);
+	return res;
+}
+
+namespace {
+
+// Internal code of the work-stack frames that build a common expression
+// (defined variable) once its nonlinear part is translated.
+const size_t CEXP_FRAME = N_OPS;
+
+}
+
+// converts an AMPL expression (sub)tree into an expression* (sub)tree
+// thank to Dominique Orban for the explication of the DAG inside AMPL:
+// http://www.gerad.ca/~orban/drampl/dag.html
+//
+// The DAG is traversed in post-order with an explicit work stack rather than
+// by recursive calls, so that the depth of the AMPL expressions is not limited
+// by the size of the C stack. The operands of a node are pushed on "todo" in
+// reverse order and their translations are accumulated on "done", in order.
+//
+// A unary minus only changes the sign of the translation of its operand, so
+// that it is absorbed by the enclosing addition or subtraction (see make_node).
+// Identical subexpressions (same operator, same constant and same operands,
+// including across constraints) are built once and shared, through the
+// hash-consing table node_table.
+//
+// The work stacks are members, reused from one call to the next.
+const ExprNode& AmplInterface::nl2expr(expr *e) {
+
+	std::vector<ExprFrame>& todo = expr_frames;
+	std::vector<Term>& done = terms;
+	std::vector<expr*>& ops = operands;
+	todo.clear();
+	done.clear();
+
+	todo.push_back(ExprFrame(e, opcode(e)));
+
+	while (!todo.empty()) {
+
+		ExprFrame& f = todo.back();
+		e = f.e;
+
+		if (!f.expanded) {
+			// push the operands of the node, or translate it at once if it is a leaf
+			f.expanded = true;
+			f.base = done.size();
+
+			// from now on, f may be invalidated by a push
+			ops.clear();
+
+			switch (f.op) {
+
+			case OPNUM:    done.push_back(number(((expr_n *)e)->v)); break;
+			case OPPLUS:
+			case OPMINUS:
+			case OPDIV:
+			case OPMULT:
+			case OPPOW:
+			case OP_atan2: {
+				ops.push_back(e->L.e);
+				ops.push_back(e->R.e);
+				break;
+			}
+			case OPCPOW:   ops.push_back(e->R.e); break;
+			case MINLIST:
+			case MAXLIST:
+			case OPSUMLIST: {
+				for (expr **ep = e->L.ep; ep < e->R.ep; ep++)
+					ops.push_back(*ep);
+				break;
+			}
+			case OPUMINUS:
+			case OP1POW:
+			case OP2POW:
+			case ABS:
+			case OP_sqrt:
+			case OP_exp:
+			case OP_log:
+			case OP_log10:
+			case OP_cos:
+			case OP_sin:
+			case OP_tan:
+			case OP_cosh:
+			case OP_sinh:
+			case OP_tanh:
+			case OP_acos:
+			case OP_asin:
+			case OP_atan:
+			case OP_asinh:
+			case OP_acosh:
+			case OP_atanh:
+			case FLOOR:
+			case CEIL:     ops.push_back(e->L.e); break;
+			//case OPintDIV: notimpl ("intdiv");
+			//case OPprecision: notimpl ("precision");
+			//case OPround:  notimpl ("round");
+			//case OPtrunc:  notimpl ("trunc");
+			//case OPFUNCALL: notimpl ("function call");
+			//case OPPLTERM:  notimpl ("plterm");
+			//case OPIFSYM:   notimpl ("ifsym");
+			//case OPHOL:     notimpl ("hol");
+			//case OPREM:   notimpl ("remainder");
+			//case OPLESS:  notimpl ("less");
+			//case OPIFnl:  // TODO return (chi(nl2expr(????))) perhaps need BoolInterval??
+			                // see ASL/solvers/rops.c, see f_OPIFnl and  expr_if
+			case OPVARVAL:  {
+				int j = ((expr_v *) e) -> a;
+				if (j<n_var) {
+					done.push_back(variable(j));
+				}
+				else {
+					// http://www.gerad.ca/~orban/drampl/def-vars.html
+					// common expression | defined variable
+					int k = (expr_v *)e - VAR_E;
+
+					if( k >= n_var && aux_vars) {
+						// This is a common expression, replaced by its auxiliary variable
+						done.push_back(term(_aux[k-n_var]));
+					}
+					else if( k >= n_var ) {
+						// This is a common expression. Find pointer to its root.
+
+						// Check if the common expression are already construct
+						if (var_data[k-n_var]) {
+							done.push_back(term(var_data[k-n_var]));
+						}
+						else {
+							// Constract the common expression, starting with the nonlinear part
+							j = k - n_var;
+							expr* ce = (j < ncom0) ? (CEXPS+j)->e : ((CEXPS1 - ncom0)+j)->e;
+							if (is_null(ce)) {
+								done.push_back(term(add_linpart(k, NULL)));
+								break;
+							}
+							todo.pop_back();
+							todo.push_back(ExprFrame(ce, CEXP_FRAME, k));
+							todo.back().expanded = true;
+							todo.back().base = done.size();
+							todo.push_back(ExprFrame(ce, opcode(ce)));
+							continue;
+						}
+					}
+					else {
+						ibex_error("Error AmplInterface: unknown defined variable \n");
+						throw -1;
+					}
+				}
+				break;
+			}
+
+			default: {
+				std::stringstream msg;
+				msg << "Error AmplInterface: unknown operator or not implemented (opcode " << f.op << ")\n";
+				ibex_error(msg.str().c_str());
+				throw -2;
+			}
+			}
+
+			if (ops.empty()) {
+				// leaf: already translated
+				todo.pop_back();
+			} else {
+				for (std::vector<expr*>::reverse_iterator it=ops.rbegin(); it!=ops.rend(); ++it)
+					todo.push_back(ExprFrame(*it, opcode(*it)));
+			}
+			continue;
+		}
+
+		// all the operands are translated: build the node
+		Term* c = &done[f.base];
+		size_t n = done.size() - f.base;
+		Term res;
+
+		switch (f.op) {
+		case OPUMINUS:   res = negate(c[0]); break;
+		case OP1POW:     res = apply(f.op, c, n, ((expr_n *)e->R.e)->v); break;
+		case OPCPOW:     res = apply(f.op, c, n, ((expr_n *)e->L.e)->v); break;
+		case CEXP_FRAME: res = term(add_linpart(f.k, &node(c[0]))); break;
+		default:         res = apply(f.op, c, n, 0);
+		}
+
+		done.resize(f.base);
+		done.push_back(res);
+		todo.pop_back();
+	}
+
+	assert(done.size()==1);
+	return node(done.back());
+}
+
+namespace {
+
+// Special operators of a token: a number, a variable
+const int NUMBER_TOKEN = -1;
+const int VARIABLE_TOKEN = -2;
+
+// Number of operands of an operator read in a .nl file: 0 for the operators
+// with a list of operands (whose length follows), -1 if the operator is not
+// supported (the file is then left to the ASL).
+int nl_arity(int op) {
+	switch (op) {
+	case OPPLUS:
+	case OPMINUS:
+	case OPMULT:
+	case OPDIV:
+	case OPPOW:
+	case OP_atan2: return 2;
+	case FLOOR:
+	case CEIL:
+	case ABS:
+	case OPUMINUS:
+	case OP_tanh:
+	case OP_tan:
+	case OP_sqrt:
+	case OP_sinh:
+	case OP_sin:
+	case OP_log10:
+	case OP_log:
+	case OP_exp:
+	case OP_cosh:
+	case OP_cos:
+	case OP_atanh:
+	case OP_atan:
+	case OP_asinh:
+	case OP_asin:
+	case OP_acosh:
+	case OP_acos:  return 1;
+	case MINLIST:
+	case MAXLIST:
+	case OPSUMLIST: return 0;
+	default:       return -1;
+	}
+}
+
+}
+
+// Reads an expression of the .nl file (in prefix notation) into tokens.
+// Only reads the file: may be called by several threads at once.
+void AmplInterface::tokenize(NlReader& r, std::vector<Token>& tokens) const {
+	tokens.clear();
+	int nb_defined = n_var+comb+comc+como+comc1+como1;
+	int missing = 1; // number of operands still to be read
+	do {
+		Token t;
+		t.op = NUMBER_TOKEN;
+		t.n = 0;
+		t.v = 0;
+		switch (r.read_char()) {
+		case 'n': t.v = r.read_double(); break;
+		case 's': t.v = r.read_short(); break;
+		case 'l': t.v = r.read_int(); break;
+		case 'v': {
+			t.op = VARIABLE_TOKEN;
+			t.n = r.read_int();
+			if (t.n<0 || t.n>=nb_defined) throw NlReader::Error();
+			break;
+		}
+		case 'o': {
+			t.op = r.read_int();
+			t.n = nl_arity(t.op);
+			if (t.n<0) throw NlReader::Error();
+			if (t.n==0) {
+				r.next_line();
+				t.n = r.read_int();
+				if (t.n<1) throw NlReader::Error();
+			}
+			missing += t.n;
+			break;
+		}
+		default: throw NlReader::Error();
+		}
+		r.next_line();
+		tokens.push_back(t);
+	} while (--missing>0);
+}
+
+// Translates an expression read by tokenize.
+AmplInterface::Term AmplInterface::build_expr(const std::vector<Token>& tokens) {
+
+	std::vector<OpFrame>& todo = op_frames;
+	std::vector<Term>& done = terms;
+	todo.clear();
+	done.clear();
+
+	for (size_t k=0; k<tokens.size(); k++) {
+		const Token& tk = tokens[k];
+		switch (tk.op) {
+		case NUMBER_TOKEN: done.push_back(number(tk.v)); break;
+		case VARIABLE_TOKEN: {
+			if (tk.n<n_var)
+				done.push_back(variable(tk.n));
+			else if (aux_vars)
+				done.push_back(term(_aux[tk.n-n_var]));
+			else if (var_data[tk.n-n_var])
+				done.push_back(term(var_data[tk.n-n_var]));
+			else
+				throw NlReader::Error(); // defined variable used before its definition
+			break;
+		}
+		default:
+			todo.push_back(OpFrame(tk.op, tk.n, done.size()));
+			continue;
+		}
+
+		// build the operators whose operands are all read
+		while (!todo.empty() && done.size()-todo.back().base==(size_t) todo.back().n) {
+			OpFrame& o = todo.back();
+			Term* t = &done[o.base];
+			Term res;
+
+			if (o.op==OPUMINUS)
+				res = negate(t[0]);
+			else
+				res = apply(o.op, t, o.n, 0);
+
+			done.resize(o.base);
+			done.push_back(res);
+			todo.pop_back();
+		}
+	}
+
+	assert(done.size()==1);
+	return done.back();
+}
+
+// the node of an expression read in the file (NULL if it is zero)
+const ExprNode* AmplInterface::read_body(NlReader& r, const std::vector<Token>* tokens) {
+	if (!tokens) {
+		tokenize(r, expr_tokens);
+		tokens = &expr_tokens;
+	}
+	Term t = build_expr(*tokens);
+	return (!t.e && t.v==Interval::zero()) ? NULL : &node(t);
+}
+
+// Reads the n bounds of a "r" or "b" segment into lu (lower and upper bounds,
+// interleaved), unless lu is NULL.
+void AmplInterface::read_bounds(NlReader& r, int n, double* lu) {
+	for (int i=0; i<n; i++) {
+		double lb, ub;
+		switch (r.read_char()) {
+		case '0': lb = r.read_double(); ub = r.read_double(); break;
+		case '1': lb = negInfinity;     ub = r.read_double(); break;
+		case '2': lb = r.read_double(); ub = Infinity;        break;
+		case '3': lb = negInfinity;     ub = Infinity;        break;
+		case '4': lb = ub = r.read_double();                  break;
+		default: throw NlReader::Error(); // complementarity constraint
+		}
+		r.next_line();
+		if (lu) {
+			lu[2*i] = lb;
+			lu[2*i+1] = ub;
+		}
+	}
+}
+
+// Reads the terms of the "J" segment s (whose header is read) at their
+// place in jac_row, jac_var and jac_coef. May be called by several threads at once.
+void AmplInterface::read_jacobian(NlReader& r, const Segment& s) {
+	for (int j=0; j<s.m; j++) {
+		int v = r.read_int();
+		if (s.goff) r.read_int();
+		double a = r.read_double();
+		r.next_line();
+		if (v<0 || v>=n_var) throw NlReader::Error();
+		jac_row[s.off+j] = s.i;
+		jac_var[s.off+j] = v;
+		jac_coef[s.off+j] = a;
+	}
+}
+
+// Reads the segment starting at the current position.
+// If build is false, the segment is only checked and s is filled (the segments
+// are indexed). Otherwise, the expressions are translated and the model is filled.
+void AmplInterface::read_segment(NlReader& r, Segment& s, bool build) {
+	int obj = get_obj_numb()-1; // the selected objective
+
+	s.type = r.read_char();
+	switch (s.type) {
+	case 'C': {
+		s.i = r.read_int();
+		r.next_line();
+		if (s.i<0 || s.i>=n_con) throw NlReader::Error();
+		if (build)
+			con_nl[s.i] = read_body(r, NULL);
+		else
+			tokenize(r, expr_tokens);
+		break;
+	}
+	case 'O': {
+		s.i = r.read_int();
+		int sense = r.read_int();
+		r.next_line();
+		if (s.i<0 || s.i>=n_obj) throw NlReader::Error();
+		if (build && s.i==obj) {
+			obj_nl = read_body(r, NULL);
+			obj_sense = sense;
+		} else
+			tokenize(r, expr_tokens);
+		break;
+	}
+	case 'V': {
+		s.i = r.read_int();
+		int nlin = r.read_int();
+		r.read_int();
+		r.next_line();
+		if (s.i<n_var || s.i>=n_var+comb+comc+como+comc1+como1 || nlin<0) throw NlReader::Error();
+		lin_var.clear();
+		lin_coef.clear();
+		for (int j=0; j<nlin; j++) {
+			lin_var.push_back(r.read_int());
+			lin_coef.push_back(r.read_double());
+			r.next_line();
+			if (lin_var.back()<0 || lin_var.back()>=n_var) throw NlReader::Error();
+		}
+		if (build) {
+			const ExprNode* body = read_body(r, NULL);
+			var_data[s.i-n_var] = &(linear_sum(body, nlin, lin_var.data(), lin_coef.data()));
+		} else
+			tokenize(r, expr_tokens);
+		break;
+	}
+	case 'r': {
+		r.next_line();
+		read_bounds(r, n_con, build ? LUrhs : NULL);
+		break;
+	}
+	case 'b': {
+		r.next_line();
+		read_bounds(r, n_var, build ? LUv : NULL);
+		break;
+	}
+	case 'k':
+	case 'K': {
+		int m = r.read_int();
+		r.next_line();
+		for (int j=0; j<m; j++) {
+			r.read_int();
+			r.next_line();
+		}
+		// from now on, the "J" segments have no column offset
+		jac_goff = false;
+		break;
+	}
+	case 'J': {
+		if (!build) {
+			s.i = r.read_int();
+			s.m = r.read_int();
+			if (s.i<0 || s.i>=n_con || s.m<0) throw NlReader::Error();
+			s.off = jac_nnz;
+			s.goff = jac_goff;
+			jac_nnz += s.m;
+		} else {
+			r.read_int();
+			r.read_int();
+		}
+		r.next_line();
+		if (build)
+			read_jacobian(r, s);
+		else {
+			// only checked
+			for (int j=0; j<s.m; j++) {
+				if (r.read_int()<0) throw NlReader::Error();
+				if (s.goff) r.read_int();
+				r.read_double();
+				r.next_line();
+			}
+		}
+		break;
+	}
+	case 'G': {
+		s.i = r.read_int();
+		int m = r.read_int();
+		r.next_line();
+		if (s.i<0 || s.i>=n_obj || m<0) throw NlReader::Error();
+		for (int j=0; j<m; j++) {
+			int v = r.read_int();
+			double a = r.read_double();
+			r.next_line();
+			if (v<0 || v>=n_var) throw NlReader::Error();
+			if (build && s.i==obj) {
+				obj_var.push_back(v);
+				obj_coef.push_back(a);
+			}
+		}
+		break;
+	}
+	case 'x': {
+		int m = r.read_int();
+		r.next_line();
+		if (build && !X0 && (want_xpi0 & 1))
+			X0 = (real*) M1zapalloc(n_var*sizeof(real));
+		for (int j=0; j<m; j++) {
+			int v = r.read_int();
+			double a = r.read_double();
+			r.next_line();
+			if (v<0 || v>=n_var) throw NlReader::Error();
+			if (build && X0) X0[v] = a;
+		}
+		break;
+	}
+	case 'd': {
+		// initial values of the dual variables: not used
+		int m = r.read_int();
+		r.next_line();
+		for (int j=0; j<m; j++) {
+			r.read_int();
+			r.read_double();
+			r.next_line();
+		}
+		break;
+	}
+	default:
+		// not supported: imported functions (F), logical constraints (L),
+		// suffixes (S), etc.
+		throw NlReader::Error();
+	}
+}
+
+// Indexes the segments of the .nl file, checking that they are all supported
+// by the native reader.
+bool AmplInterface::index_segments() {
+	NlReader& r = *reader;
+	r.rewind();
+	segments.clear();
+	jac_nnz = 0;
+	jac_goff = true;
+
+	try {
+		while (!r.at_end()) {
+			Segment s;
+			s.pos = r.pos();
+			s.i = s.m = s.off = 0;
+			s.goff = false;
+			read_segment(r, s, false);
+			segments.push_back(s);
+		}
+	} catch (NlReader::Error&) {
+		return false;
+	}
+	return true;
+}
+
+// Reads (into con_tokens and the Jacobian) the "C" and "J" segments of
+// index first, first+step, first+2*step, etc. Run by each thread of read_native.
+// A malformed segment sets failed; any other exception is stored in error
+// (an exception escaping a thread would terminate the program).
+void AmplInterface::parse_segments(size_t first, size_t step, char* failed, std::exception_ptr* error) {
+	// each thread has its own position in the file
+	NlReader r(*reader);
+	try {
+		for (size_t k=first; k<segments.size(); k+=step) {
+			const Segment& s = segments[k];
+			if ((s.type!='C' || lazy || streaming) && s.type!='J') continue;
+			r.seek(s.pos);
+			r.read_char();
+			r.read_int();
+			if (s.type=='J') r.read_int();
+			r.next_line();
+			if (s.type=='C')
+				tokenize(r, con_tokens[s.i]);
+			else
+				read_jacobian(r, s);
+		}
+	} catch (NlReader::Error&) {
+		*failed = 1;
+	} catch (...) {
+		*error = std::current_exception();
+	}
+}
+
+// Reads the model with the native reader (the segments have been indexed
+// in readASLfg). The bounds are stored as the ASL would do.
+//
+// With several threads, the constraint bodies ("C" segments) and the Jacobian
+// ("J" segments), which make the bulk of large files, are first parsed
+// concurrently. Ibex nodes are then built sequentially, in file order
+// (the hash-consing table and the defined variables are shared).
+bool AmplInterface::read_native() {
+	LUv = (real*) M1alloc(2*n_var*sizeof(real));
+	Uvx = NULL;
+	for (int i=0; i<n_var; i++) {
+		LUv[2*i] = negInfinity;
+		LUv[2*i+1] = Infinity;
+	}
+	LUrhs = (real*) M1alloc(2*n_con*sizeof(real));
+	Urhsx = NULL;
+	for (int i=0; i<n_con; i++) {
+		LUrhs[2*i] = negInfinity;
+		LUrhs[2*i+1] = Infinity;
+	}
+	con_nl.assign(n_con, NULL);
+	// with the lazy or streaming mode, the constraints are read later, one by one
+	bool defer = lazy || streaming;
+	if (defer) con_pos.assign(n_con, 0);
+	jac_row.resize(jac_nnz);
+	jac_var.resize(jac_nnz);
+	jac_coef.resize(jac_nnz);
+
+	size_t nb_threads = get_nl_threads();
+	if (nb_threads==0) nb_threads = std::thread::hardware_concurrency();
+	if (nb_threads==0) nb_threads = 1;
+	if (nb_threads>segments.size()) nb_threads = segments.size();
+
+	bool ok = true;
+
+	if (nb_threads>1) {
+		con_tokens.resize(n_con);
+		std::vector<char> failed(nb_threads, 0);
+		std::vector<std::exception_ptr> errors(nb_threads);
+		std::vector<std::thread> threads;
+		for (size_t t=0; t<nb_threads; t++)
+			threads.push_back(std::thread(&AmplInterface::parse_segments, this, t, nb_threads, &failed[t], &errors[t]));
+		for (size_t t=0; t<nb_threads; t++) {
+			threads[t].join();
+			if (failed[t]) ok = false;
+		}
+		// rethrown once all the threads are joined
+		for (size_t t=0; t<nb_threads; t++)
+			if (errors[t]) std::rethrow_exception(errors[t]);
+	}
+
+	NlReader& r = *reader;
+	try {
+		// the bounds first, for the fixed variables
+		for (size_t k=0; ok && k<segments.size(); k++) {
+			if (segments[k].type!='b') continue;
+			r.seek(segments[k].pos);
+			read_segment(r, segments[k], true);
+		}
+		fix_vars();
+
+		for (size_t k=0; ok && k<segments.size(); k++) {
+			Segment& s = segments[k];
+			if (s.type=='b') continue; // already read
+			if (defer && s.type=='C') {
+				// read on demand (see get_ctr_expr)
+				con_pos[s.i] = s.pos;
+				continue;
+			}
+			if (nb_threads>1 && s.type=='J') continue; // already read
+			r.seek(s.pos);
+			if (nb_threads>1 && s.type=='C') {
+				r.read_char();
+				con_nl[s.i] = read_body(r, &con_tokens[s.i]);
+				std::vector<Token>().swap(con_tokens[s.i]);
+			} else
+				read_segment(r, s, true);
+			if (s.type=='C') count_pending_row();
+		}
+	} catch (NlReader::Error&) {
+		ok = false;
+	}
+
+	con_tokens.clear();
+	segments.clear();
+
+	// the file is not needed anymore (unless the constraints are read later)
+	if (!defer || !ok) {
+		con_pos.clear();
+		delete reader;
+		reader = NULL;
+	}
+	return ok;
+}
 
 }
 
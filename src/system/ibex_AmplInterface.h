@@ -20,21 +20,12 @@
 //#include "ibex/ibex_OptimizerConfig.h"
 
 #include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <exception>
 
-#ifdef __GNUC__
-#include <ciso646> // just to initialize _LIBCPP_VERSION
-#ifdef _LIBCPP_VERSION
-#include <unordered_map>
-#else
-#include <tr1/unordered_map>
-#endif
-#else
-#if (_MSC_VER >= 1600)
-#include <unordered_map>
-#else
-#include <unordered_map>
-#endif // (_MSC_VER >= 1600)
-#endif
+#include "ibex_NodeTable.h"
 
 
 struct ASL;
@@ -43,6 +34,7 @@ struct expr;
 
 namespace ibex {
 
+class NlReader;
 
 
 class AmplInterface : public SystemFactory  {
@@ -53,9 +45,100 @@ public:
 
 	bool writeSolution(Optimizer& o);
 
+	/**
+	 * \brief Write the .sol file from a result obtained otherwise (e.g., by
+	 * solving the components of the system separately).
+	 *
+	 * \param loup_point - the best feasible point found (in the system)
+	 * \param time_limit - the timeout (for the message of TIME_OUT)
+	 */
+	bool writeSolution(Optimizer::Status status, const IntervalVector& loup_point, double time_limit);
+
+	/**
+	 * \brief Write the .sol file of a model without objective, solved by s.
+	 *
+	 * The point written is the center of the first box certified to
+	 * contain a solution or, if there is none, of the first boundary
+	 * (or unknown) box.
+	 *
+	 * \param status - the status returned by the search.
+	 */
+	bool writeSolution(Solver& s, Solver::Status status);
+
+	/**
+	 * \brief The initial point of the AMPL model (primal values X0).
+	 *
+	 * x must have the size of the system. The fixed variables are skipped.
+	 * Returns false if the model has no initial point (or with auxiliary
+	 * variables, whose initial values are unknown).
+	 */
+	bool get_x0(Vector& x) const;
+
+	/**
+	 * \brief The start point of the search (see #set_start_priority()).
+	 *
+	 * The values of the suffix "ibex_start" of the variables if it is
+	 * given in the model, the initial point (see #get_x0()) otherwise.
+	 * Returns false if there is none.
+	 */
+	bool get_start_point(Vector& x) const;
+
+	/** Number of constraints of the AMPL model. */
+	int get_nb_ampl_ctr() const;
+
+	/** Index of the AMPL constraint named name, or -1 if there is none. */
+	int find_ctr(const std::string& name);
+
+	/**
+	 * \brief Expression of the i-th AMPL constraint (without its bounds).
+	 *
+	 * The expression is translated at the first call (see #set_lazy()).
+	 */
+	const ExprNode& get_ctr_expr(int i);
+
+	/** Bounds of the i-th AMPL constraint. */
+	Interval get_ctr_bounds(int i) const;
+
+	/**
+	 * \brief Add the i-th AMPL constraint to the system (if not already added).
+	 *
+	 * The constraints of the system are in the order of the calls.
+	 */
+	void load_ctr(int i);
+
+	/** \see #load_ctr(int). */
+	void load_ctr(const std::string& name);
+
+	/** Add all the AMPL constraints that are not added yet. */
+	void load_all_ctrs();
+
+	/** \see #set_lazy(). */
+	int get_lazy() const;
+
+	/** \see #set_streaming(). */
+	int get_streaming() const;
+
+	/** Maximal number of constraints read in the .nl file by the native
+	 *  reader and not added yet to the system, during the loading (1 in
+	 *  streaming mode, the number of constraints otherwise). */
+	int get_max_pending_rows() const;
+
+	/** \see #set_simpl_budget(). */
+	double get_simpl_budget() const;
+
+	/** Number of expressions simplified at the given level (0 to 3)
+	 *  by the adaptive simplification (see #set_simpl_budget()). */
+	int get_simpl_count(int level) const;
+
+	/** Time spent (in seconds) by the adaptive simplification. */
+	double get_simpl_time() const;
+
 	/** see #set_rel_eps_f(). */
 	double get_rel_eps_f() const;
 
+	/** \see #set_aux_vars(). */
+	int get_aux_vars() const;
+
 	/** see #set_abs_eps_f(). */
 	double get_abs_eps_f() const;
 
@@ -65,6 +148,90 @@ public:
 	/** \see #set_rigor(). */
 	int get_rigor() const;
 
+	/** \see #set_presolve(). */
+	int get_presolve() const;
+
+	/** Number of variables fixed (by the model or by the presolve) and
+	 *  removed from the system (see #set_presolve()). */
+	int get_nb_fixed() const;
+
+	/** Number of AMPL constraints on a single variable that were put in
+	 *  the bounds of the variable (see #set_presolve()). */
+	int get_nb_bound_rows() const;
+
+	/** Number of AMPL constraints removed by the presolve because they
+	 *  are satisfied by all the points of the initial box. */
+	int get_nb_redundant_rows() const;
+
+	/** Number of AMPL constraints removed by the presolve because they are
+	 *  identical or parallel to another one. */
+	int get_nb_duplicate_rows() const;
+
+	/** Number of bounds of variables tightened by the presolve. */
+	int get_nb_tightened() const;
+
+	/** The AMPL constraint of the c-th constraint of the system (-1 for the
+	 *  defining equality of an auxiliary variable). A range constraint may
+	 *  give two constraints of the system and a constraint put in the bounds
+	 *  gives none. */
+	int get_ampl_row(int c) const;
+
+	/** \see #set_decompose(). */
+	int get_decompose() const;
+
+	/** Number of independent subproblems of the system
+	 *  (1 if it is not decomposed, see #set_decompose()). */
+	int get_nb_components() const;
+
+	/** The subproblem of the i-th variable of the system. */
+	int get_component(int i) const;
+
+	/**
+	 * \brief The k-th subproblem of the system sys built from this interface.
+	 *
+	 * Its variables are the variables of the component (in the same order),
+	 * its constraints the constraints on them and its objective the sum of
+	 * the terms of the objective on them (with the constant terms for the
+	 * first component). The minimum of the objective is the sum of the minima
+	 * of the subproblems.
+	 *
+	 * Returns NULL if the objective or a constraint of sys mixes variables of
+	 * several components (e.g., if the objective is not a sum after the
+	 * simplification). The system must be deleted by the caller.
+	 */
+	System* get_component_system(const System& sys, int k) const;
+
+	/** The variables of the system in the k-th subproblem (in increasing
+	 *  order, as in #get_component_system()). */
+	std::vector<int> get_component_vars(int k) const;
+
+	/** The constraints of sys in the k-th subproblem (in increasing
+	 *  order, as in #get_component_system()). */
+	std::vector<int> get_component_ctrs(const System& sys, int k) const;
+
+	/** \see #set_blocks(). */
+	int get_blocks() const;
+
+	/** Number of blocks of equations (see #set_blocks()). */
+	int get_nb_blocks() const;
+
+	/** The constraints of the system in the b-th block of equations
+	 *  (in increasing order). */
+	const std::vector<int>& get_block_ctrs(int b) const;
+
+	/** The variables of the system of the b-th block of equations,
+	 *  the k-th being matched with the k-th constraint of the block. */
+	const std::vector<int>& get_block_vars(int b) const;
+
+	/** \see #set_first_sol(). */
+	int get_first_sol() const;
+
+	/** \see #set_warm_start(). */
+	int get_warm_start() const;
+
+	/** \see #set_start_priority(). */
+	int get_start_priority() const;
+
 	/** \see #set_inHC4(). */
 	int get_inHC4() const;
 
@@ -86,44 +253,282 @@ public:
 	/** \see #set_obj_numb(). */
 	int get_obj_numb() const;
 
+	/** \see #set_linear_form(). */
+	int get_linear_form() const;
+
+	/** Reader actually used for the .nl file: 0 = ASL, 1 = native reader.
+	 * The native reader is used if the keyword "nl_reader" is set to 1
+	 * and the file only contains segments it supports. If it fails while
+	 * building the model, the file is read again by the ASL. */
+	int get_nl_reader() const;
+
+	/** \see #set_nl_threads(). */
+	int get_nl_threads() const;
+
+	/** Ratio of the translated nodes that were found in the hash-consing
+	 *  table (i.e., shared with an identical node) instead of being created. */
+	double get_sharing_ratio() const;
+
+	/** Number of operations whose operands were all constants and that
+	 *  were folded into a single constant at translation time. */
+	long get_nb_folded() const;
+
+	/** Opcode of an AMPL expression node (see opcode.hd of the ASL),
+	 *  or -1 if its operator is unknown. */
+	static int opcode(const expr* e);
+
 private:
 
 	ASL*     asl;
 	std::string _nlfile;
 	const ExprSymbol ** _x;
 
-	/**  var_data: map which containts expressions of the temporary variable already defined */
-	/**  opmap: map to convert efunc* of AMPL to an operator */
-#ifdef __GNUC__
-#include <ciso646> // just to initialize _LIBCPP_VERSION
-#ifdef _LIBCPP_VERSION
-	std::unordered_map<int, const ExprNode*> var_data;
-	std::unordered_map<size_t, size_t> opmap;
-#else
-	std::tr1::unordered_map<int, const ExprNode*> var_data;
-	std::tr1::unordered_map<size_t, size_t> opmap;
-#endif
-#else
-#if (_MSC_VER >= 1600)
-	std::unordered_map<int, const ExprNode*> var_data
-	std::unordered_map<size_t, size_t> opmap;
-#else
-	std::tr1::unordered_map<int, const ExprNode*> var_data;
-	std::tr1::unordered_map<size_t, size_t> opmap;
-#endif // (_MSC_VER >= 1600)
-#endif
+	/** index of each variable of the model in the system, -1 if the variable
+	 *  is fixed (see #set_presolve()), its value being then in var_value */
+	std::vector<int> var_index;
+	std::vector<double> var_value;
+
+	/** the auxiliary variables of the defined variables (see #set_aux_vars()) */
+	std::vector<const ExprSymbol*> _aux;
+
+	/** the values of the suffix "ibex_start" of the variables (empty if not given) */
+	std::vector<double> start_suffix;
+
+	/** a translated (sub)expression: its node (NULL for a number, whose value is v,
+	 *  the node being built only if needed), to be negated if neg is true.
+	 *  The value of a folded constant is an interval. */
+	struct Term {
+		const ExprNode* e;
+		bool neg;
+		Interval v;
+	};
+
+	/** an expression node read in a .nl file: an operator (with n operands),
+	 *  a number v (op=-1) or the variable n (op=-2) */
+	struct Token {
+		int op;
+		int n;
+		double v;
+	};
+
+	/** a segment of a .nl file: its letter, its position and, for the
+	 *  "C", "O", "V", "J" and "G" segments, the index of the constraint
+	 *  (objective, variable). For a "J" segment: its number of terms m,
+	 *  the position of its first term in the Jacobian and whether the
+	 *  terms have a column offset (no "k" segment before). */
+	struct Segment {
+		char type;
+		size_t pos;
+		int i;
+		int m;
+		size_t off;
+		bool goff;
+	};
+
+	/** a node of the AMPL DAG waiting for the translation of its operands (see nl2expr) */
+	struct ExprFrame {
+		ExprFrame(expr* e, size_t op, int k=-1) : e(e), op(op), k(k), expanded(false), base(0) { }
+		expr* e;         // the AMPL node (the nonlinear part for a common expression frame)
+		size_t op;       // the operator (or the code of a common expression frame)
+		int k;           // index of the defined variable (common expression frame only)
+		bool expanded;   // true once the operands are pushed
+		size_t base;     // position of the first translated operand in the result stack
+	};
+
+	/** an operator of a .nl expression waiting for its operands (see build_expr) */
+	struct OpFrame {
+		OpFrame(int op, int n, size_t base) : op(op), n(n), base(base) { }
+		int op;          // the operator
+		int n;           // its number of operands
+		size_t base;     // position of its first operand in the result stack
+	};
+
+	/**  var_data: expressions of the temporary variables already defined: var_data[k-n_var]
+	 *   for the defined variable k (NULL if not translated yet) */
+	std::vector<const ExprNode*> var_data;
+
+	/**  node_table: hash-consing table of the translated nodes */
+	NodeTable node_table;
+
+	/** work stacks of the translation (reused between calls) */
+	std::vector<ExprFrame> expr_frames;
+	std::vector<OpFrame> op_frames;
+	std::vector<Term> terms;
+	std::vector<expr*> operands;
+	std::vector<Interval> fold_args;
 
 	bool readnl();
+	bool load_row(int i);
+
+	/** Counts a "C" segment read and not added yet to the system. */
+	void count_pending_row();
+	void release_data();
 	bool readoption();
 	bool readASLfg();
+	bool read_fg(FILE* nl);
+	bool fallback_asl();
 	const ExprNode& nl2expr(expr *e);
+	bool is_null(expr *e);
+	const ExprNode* add_linpart(int k, const ExprNode* body);
+	const ExprNode& defined_var(int k);
+	const ExprNode& linear_sum(const ExprNode* body, int n, const int* var, const double* coef);
+	void read_linear_rows();
+	const ExprNode* row_nl(int i);
+	const ExprNode& row_expr(int i);
+	void row_terms(int i, std::vector<int>& var, std::vector<double>& coef, Interval& b);
+	void merge_rows();
+	void find_components(const ExprNode* obj_body);
+	void find_blocks();
+	int expr_component(const ExprNode& e, const std::map<const ExprSymbol*,int>& x) const;
+	int ctr_component(const System& sys, int c) const;
+	bool add_row(int i, const ExprNode& f);
+	void fix_vars();
+	bool linear_row(int i);
+	bool presolve_row(int i, IntervalVector& bound, bool& changed);
+	void presolve_rows(IntervalVector& bound);
+	Vector ampl_point(const Vector& x) const;
+	const ExprNode& simplified(const ExprNode& e);
+	const ExprNode* find_node(int op, const Term* t, size_t n, double cst);
+	Term number(const Interval& v);
+	Term variable(int j);
+	Term term(const ExprNode* e);
+	const ExprNode& node(Term& t);
+	const ExprNode* make_node(int op, Term* t, size_t n, double cst);
+	Term apply(int op, Term* t, size_t n, double cst);
+	Term negate(const Term& t);
+	void tokenize(NlReader& r, std::vector<Token>& tokens) const;
+	Term build_expr(const std::vector<Token>& tokens);
+	const ExprNode* read_body(NlReader& r, const std::vector<Token>* tokens);
+	void read_bounds(NlReader& r, int n, double* lu);
+	void read_jacobian(NlReader& r, const Segment& s);
+	void read_segment(NlReader& r, Segment& s, bool build);
+	bool index_segments();
+	void parse_segments(size_t first, size_t step, char* failed, std::exception_ptr* error);
+	bool read_native();
+
+	/** linear part of the constraints, row by row: the terms of the
+	 *  i-th constraint are (row_var[k], row_coef[k]) for k in [row_start[i], row_start[i+1][ */
+	std::vector<int> row_start;
+	std::vector<int> row_var;
+	std::vector<double> row_coef;
+
+	/** the mapped .nl file, when read by the native reader (NULL otherwise) */
+	NlReader* reader;
+
+	/** position of the first segment of the .nl file (end of the header) */
+	long nl_offset;
+
+	/** model read by the native reader: nonlinear part of the constraints
+	 *  (NULL if none), linear part of the constraints (jac_row[k], jac_var[k], jac_coef[k]),
+	 *  nonlinear part, linear part and sense (0 = min, 1 = max) of the selected objective */
+	std::vector<const ExprNode*> con_nl;
+	std::vector<int> jac_row;
+	std::vector<int> jac_var;
+	std::vector<double> jac_coef;
+	const ExprNode* obj_nl;
+	std::vector<int> obj_var;
+	std::vector<double> obj_coef;
+	int obj_sense;
+
+	/** translated expressions of the AMPL constraints (NULL if not translated yet),
+	 *  constraints added to the system */
+	std::vector<const ExprNode*> ctr_expr;
+	std::vector<bool> ctr_loaded;
+
+	/** indices of the AMPL constraints by name (built at the first call to find_ctr) */
+	std::map<std::string,int> ctr_index;
+
+	/** position of the "C" segment of each constraint not translated yet (lazy
+	 *  mode with the native reader, 0 if translated) */
+	std::vector<size_t> con_pos;
+
+	/** segments of the file (native reader), number of terms of the Jacobian,
+	 *  whether the next "J" segment has column offsets (while indexing) */
+	std::vector<Segment> segments;
+	size_t jac_nnz;
+	bool jac_goff;
+
+	/** the expression being read and the constraint bodies read in parallel */
+	std::vector<Token> expr_tokens;
+	std::vector<std::vector<Token> > con_tokens;
+
+	/** number of nodes looked up in / found in the hash-consing table */
+	long nb_nodes;
+	long nb_shared_nodes;
+
+	/** number of operations folded into a constant */
+	long nb_folded;
+
+	/** number of "C" segments read and not added yet to the system
+	 *  (native reader), and its maximum (see #get_max_pending_rows()) */
+	int nb_pending_rows;
+	int max_pending_rows;
+
+	/** statistics of the presolve: number of fixed variables, of constraints
+	 *  put in the bounds, of redundant constraints and of tightened bounds */
+	int nb_fixed;
+	int nb_bound_rows;
+	int nb_redundant_rows;
+	int nb_tightened;
+	int nb_duplicate_rows;
+
+	/** the component of each variable of the system (see #set_decompose()) */
+	std::vector<int> var_comp;
+	int nb_components;
+
+	/** the constraints and variables of each block of equations (see #set_blocks()) */
+	std::vector<std::vector<int> > block_ctrs;
+	std::vector<std::vector<int> > block_vars;
+
+	/** the bounds of each constraint merged with its parallel constraints
+	 *  (see merge_rows()), empty if none */
+	std::vector<Interval> row_rhs;
+
+	/** the AMPL constraint of each constraint added to the system */
+	std::vector<int> ctr_rows;
+
+	/** the symbols of the system (to copy the expressions) */
+	Array<const ExprSymbol>* simpl_symbols;
+
+	/** the nodes of the expressions replaced by a simplified copy, and
+	 *  of the ones given as is, by the adaptive simplification */
+	std::set<const ExprNode*> simpl_originals, simpl_kept;
+
+	/** maximal level of the adaptive simplification, time spent and
+	 *  number of expressions simplified at each level */
+	int simpl_max_level;
+	double simpl_time;
+	int simpl_count[4];
+
+	/** buffers for the linear terms and the sums (reused between calls) */
+	std::vector<int> lin_var;
+	std::vector<double> lin_coef;
+	std::vector<const ExprNode*> sum_terms;
+	std::vector<bool> sum_neg;
 
 	/** Absolute precision on the objective function. Default: 1.e-7. */
 	double abs_eps_f;
 
+	/** Defined variables as auxiliary variables. Default: 0.
+	 * \see #set_aux_vars(). */
+	int aux_vars;
+
+	/** Contract the blocks of equations. Default: 0.
+	 * \see #set_blocks(). */
+	int blocks;
+
+	/** Split the system into independent subproblems. Default: 0.
+	 * \see #set_decompose(). */
+	int decompose;
+
 	/** Relaxation value of the equality constraints. Default: 1.e-8.  */
 	double eps_h;
 
+	/** Stop the search of a model without objective at the first
+	 *  certified solution. Default: 0.
+	 * \see #set_first_sol(). */
+	int first_sol;
+
 	/** Initialization of the upper bound with a known value. Default: +infinity. */
 	double init_obj_value;
 
@@ -135,9 +540,29 @@ private:
 	 * \see #set_kkt().  */
 	int kkt;
 
+	/** Translate the constraints only on demand. Default: 0.
+	 * \see #set_lazy(). */
+	int lazy;
+
+	/** Translate linear parts into sparse dot products. Default: 0.
+	 * \see #set_linear_form(). */
+	int linear_form;
+
+	/** Reader of the .nl file (0 = ASL, 1 = native). Default: 0.
+	 * \see #get_nl_reader(). */
+	int nl_reader;
+
+	/** Number of threads of the native reader. Default: 1.
+	 * \see #set_nl_threads(). */
+	int nl_threads;
+
 	/** Choose which objective function of the AMPL model: 0 = none, 1 = first. Default: 1. */
 	int obj_numb;
 
+	/** Reduction of the model when it is loaded. Default: 0.
+	 * \see #set_presolve(). */
+	int presolve;
+
 	/** Random seed (useful for reproducibility). Default: 1.  */
 	double random_seed;
 
@@ -148,12 +573,28 @@ private:
 	 * \see #set_rigor(). */
 	int rigor;
 
+	/** Time budget of the adaptive simplification. Default: -1 (none).
+	 * \see #set_simpl_budget(). */
+	double simpl_budget;
+
+	/** Number of nodes where the boxes containing the start point are explored first. Default: 0.
+	 * \see #set_start_priority(). */
+	int start_priority;
+
+	/** Release the data read as soon as the constraints are translated. Default: 0.
+	 * \see #set_streaming(). */
+	int streaming;
+
 	/** Timeout (time in seconds). Default: -1 (none).  */
 	double timeout;
 
 	/** Activate trace. Updates of lower and upper bound are printed while minimizing. Default: 1.  */
 	int trace;
 
+	/** Warm start from the initial point. Default: 0.
+	 * \see #set_warm_start(). */
+	int warm_start;
+
 
 	/**
 	 * \brief Set relative precision on the objective.
@@ -259,6 +700,181 @@ private:
 	 */
 	void set_obj_numb(int num);
 
+	/**
+	 * \brief Set the translation of the linear parts.
+	 *
+	 * Possible value:
+	 * * 0 : each linear term coeff*x[j] is a product node, the terms are summed.
+	 * * 1 : the linear part of a constraint (or objective) with at least two
+	 *       terms is a single node, the dot product of a constant row vector
+	 *       (the coefficients) and the column vector of the variables.
+	 *       Only the nonlinear part remains a general expression.
+	 */
+	void set_linear_form(int linear_form);
+
+	/**
+	 * \brief Set the number of threads of the native reader.
+	 *
+	 * The constraint bodies and the Jacobian are parsed concurrently,
+	 * the expressions being built afterwards in constraint order.
+	 * 0 means one thread per core.
+	 */
+	void set_nl_threads(int nb);
+
+	/**
+	 * \brief Set the lazy mode.
+	 *
+	 * Possible value:
+	 * * 0 : all the constraints are translated and added to the system
+	 *       when the file is loaded.
+	 * * 1 : the variables, the bounds and the objective are loaded, but the
+	 *       constraints are only translated when requested
+	 *       (see #get_ctr_expr() and #load_ctr()). The model read by the ASL
+	 *       (or the mapped file, with the native reader) is kept until then.
+	 */
+	void set_lazy(int lazy);
+
+	/**
+	 * \brief Set the streaming mode.
+	 *
+	 * If 1, each "C" segment is read, translated and added to the system
+	 * in turn, after the other segments (bounds, Jacobian, defined
+	 * variables), so that the expressions read are not all kept at once.
+	 * This requires the native reader, selected by the "streaming" keyword
+	 * unless "nl_reader" is 0. With the ASL (binary file, segment not
+	 * supported or nl_reader=0), the model read by the ASL cannot be freed
+	 * piecewise and is kept until the end, as without streaming.
+	 * Ignored in lazy mode.
+	 */
+	void set_streaming(int streaming);
+
+	/**
+	 * \brief Set the translation of the defined variables (common expressions).
+	 *
+	 * Possible value:
+	 * * 0 : each reference to a defined variable is replaced by its
+	 *       expression (shared by all the references).
+	 * * 1 : each defined variable becomes an auxiliary variable v (added
+	 *       after the variables of the model) with the defining equality
+	 *       v - expr = 0 (added after the constraints of the model).
+	 *       The system is larger, but each expression is small and the
+	 *       contractors can propagate through the auxiliary variables.
+	 */
+	void set_aux_vars(int aux_vars);
+
+	/**
+	 * \brief Set the time budget (in seconds) of the adaptive simplification.
+	 *
+	 * If positive, each constraint (and the goal) is simplified when it is
+	 * added, with a level chosen according to its size: 3 for the small
+	 * expressions, then 2, 1 and 0 for the largest ones. A level that takes
+	 * more than a tenth of the budget on one expression is not tried anymore,
+	 * and once the budget is spent the next expressions are not simplified
+	 * (nor copied). The time is only checked between two expressions: the
+	 * simplification of one expression is not interrupted, its duration
+	 * being only limited by the size of the expressions tried at each level.
+	 * The simplification level of the system (#set_simplification_level())
+	 * is then 0. If the keyword "simpl_level" is also given, it is the
+	 * maximal level.
+	 */
+	void set_simpl_budget(double budget);
+
+	/**
+	 * \brief Set the presolve.
+	 *
+	 * If 1, the model is reduced when it is loaded:
+	 * * each variable whose lower and upper bounds are equal is replaced
+	 *   by its value in all the expressions and is not a variable of the
+	 *   system. Its value is put back in the solution written by
+	 *   #writeSolution().
+	 * * each linear constraint on a single variable (a*x+b in [lb,ub])
+	 *   is put in the bounds of the variable instead of being added
+	 *   (see #get_ampl_row()).
+	 * * each linear constraint satisfied by all the points of the box
+	 *   (computed by interval arithmetic) is removed.
+	 * * among constraints with the same nonlinear part and proportional
+	 *   linear parts (e.g., x+y<=1 and 2x+2y>=-1), only the first one is
+	 *   added, with the intersection of their bounds (-1/2<=x+y<=1). Not
+	 *   in lazy or streaming mode (all the constraints would have to be
+	 *   read first).
+	 * * the bounds of the variables are tightened with the linear
+	 *   constraints (e.g., x+y<=1 with y>=0 gives x<=1). The variables
+	 *   fixed this way are removed too (except with the native reader,
+	 *   where the expressions are built before).
+	 *
+	 * These reductions are repeated until no bound is tightened anymore.
+	 */
+	void set_presolve(int presolve);
+
+	/**
+	 * \brief Set the decomposition into independent subproblems.
+	 *
+	 * If 1, the variables are split when the model is loaded into the
+	 * connected components of the graph where a variable is linked to the
+	 * variables of the same constraint (Jacobian structure) or of the same
+	 * nonlinear term of the objective (see #get_component_system()).
+	 * Each subproblem can then be solved by its own optimizer, one after
+	 * the other, with the time left (ibexopt does it with -AMPL only, when
+	 * no initial loup is given: the COV output is for the whole system).
+	 *
+	 * Ignored in lazy mode and with auxiliary variables.
+	 */
+	void set_decompose(int decompose);
+
+	/**
+	 * \brief Set the block-triangular decomposition of the equations.
+	 *
+	 * If 1, the equations of the system are split when the model is loaded
+	 * into square blocks (Dulmage-Mendelsohn decomposition of the Jacobian
+	 * structure): each equation is matched with one of its variables, and
+	 * a block is a strongly connected component of the equations, given in
+	 * the order in which they can be solved (a block only depends on the
+	 * variables of the previous blocks and on the unmatched variables).
+	 * The optimizer then contracts the blocks in this order with interval
+	 * Newton (see CtcBlocks).
+	 *
+	 * Ignored in lazy mode and with auxiliary variables.
+	 */
+	void set_blocks(int blocks);
+
+	/**
+	 * \brief Set the search of a model without objective.
+	 *
+	 * Such a model is solved by a solver (paving of the box) instead of
+	 * an optimizer. If 1, the search stops at the first box certified to
+	 * contain a solution (for a quick feasibility check). If 0, the whole
+	 * box is paved.
+	 */
+	void set_first_sol(int first_sol);
+
+	/**
+	 * \brief Set the warm start of the optimizer.
+	 *
+	 * If 1, the initial point of the model (see #get_x0()) is used to seed
+	 * the upper bound of the objective if it is feasible (see
+	 * AmplOptimizerConfig::warm_start()). Default: 0.
+	 *
+	 * ibexopt only applies it with -AMPL: when the search finds no better
+	 * point, the warm start point is written to the .sol file, whereas a
+	 * COV file can only hold the points found by the optimizer.
+	 */
+	void set_warm_start(int warm_start);
+
+	/**
+	 * \brief Set the priority of the start point in the search.
+	 *
+	 * During the first start_priority nodes of the optimizer, the boxes
+	 * containing the start point (see #get_start_point()) are explored
+	 * before the other ones, so that the search dives towards this point
+	 * (see CellBufferStart). The start point can be given in AMPL by:
+	 *
+	 *   suffix ibex_start;
+	 *   let x.ibex_start := 1;
+	 *
+	 * If 0, the order of the default buffer is kept.
+	 */
+	void set_start_priority(int start_priority);
+
 };
 
 
@@ -271,6 +887,40 @@ inline double AmplInterface::get_eps_h() const       { return eps_h; }
 
 inline int   AmplInterface::get_rigor() const      { return rigor; }
 
+inline int   AmplInterface::get_presolve() const   { return presolve; }
+
+inline int   AmplInterface::get_decompose() const  { return decompose; }
+
+inline int   AmplInterface::get_nb_components() const { return nb_components; }
+
+inline int   AmplInterface::get_component(int i) const { return var_comp[i]; }
+
+inline int   AmplInterface::get_blocks() const     { return blocks; }
+
+inline int   AmplInterface::get_first_sol() const  { return first_sol; }
+
+inline int   AmplInterface::get_warm_start() const { return warm_start; }
+
+inline int   AmplInterface::get_start_priority() const { return start_priority; }
+
+inline int   AmplInterface::get_nb_blocks() const  { return block_ctrs.size(); }
+
+inline const std::vector<int>& AmplInterface::get_block_ctrs(int b) const { return block_ctrs[b]; }
+
+inline const std::vector<int>& AmplInterface::get_block_vars(int b) const { return block_vars[b]; }
+
+inline int   AmplInterface::get_nb_fixed() const   { return nb_fixed; }
+
+inline int   AmplInterface::get_nb_bound_rows() const { return nb_bound_rows; }
+
+inline int   AmplInterface::get_nb_redundant_rows() const { return nb_redundant_rows; }
+
+inline int   AmplInterface::get_nb_tightened() const { return nb_tightened; }
+
+inline int   AmplInterface::get_nb_duplicate_rows() const { return nb_duplicate_rows; }
+
+inline int   AmplInterface::get_ampl_row(int c) const { return ctr_rows[c]; }
+
 inline int   AmplInterface::get_inHC4() const      { return inHC4; }
 
 inline int   AmplInterface::get_kkt() const        { return kkt; }
@@ -285,6 +935,30 @@ inline double AmplInterface::get_init_obj_value() const { return init_obj_value;
 
 inline int    AmplInterface::get_obj_numb() const       { return obj_numb; }
 
+inline int    AmplInterface::get_linear_form() const    { return linear_form; }
+
+inline int    AmplInterface::get_nl_reader() const      { return nl_reader; }
+
+inline int    AmplInterface::get_nl_threads() const     { return nl_threads; }
+
+inline int    AmplInterface::get_aux_vars() const       { return aux_vars; }
+
+inline int    AmplInterface::get_lazy() const           { return lazy; }
+
+inline int    AmplInterface::get_streaming() const      { return streaming; }
+
+inline double AmplInterface::get_sharing_ratio() const  { return nb_nodes>0 ? ((double) nb_shared_nodes)/nb_nodes : 0; }
+
+inline long AmplInterface::get_nb_folded() const  { return nb_folded; }
+
+inline int  AmplInterface::get_max_pending_rows() const { return max_pending_rows; }
+
+inline double AmplInterface::get_simpl_budget() const   { return simpl_budget; }
+
+inline int    AmplInterface::get_simpl_count(int level) const { return simpl_count[level]; }
+
+inline double AmplInterface::get_simpl_time() const     { return simpl_time; }
+
 
 
 inline void AmplInterface::set_rel_eps_f(double _rel_eps_f)  { rel_eps_f = _rel_eps_f; }
@@ -309,6 +983,30 @@ inline void AmplInterface::set_init_obj_value(double bound) { init_obj_value = b
 
 inline void AmplInterface::set_obj_numb(int num)        { obj_numb = num; }
 
+inline void AmplInterface::set_linear_form(int _linear_form) { linear_form = _linear_form; }
+
+inline void AmplInterface::set_nl_threads(int nb)       { nl_threads = nb; }
+
+inline void AmplInterface::set_aux_vars(int _aux_vars)  { aux_vars = _aux_vars; }
+
+inline void AmplInterface::set_lazy(int _lazy)          { lazy = _lazy; }
+
+inline void AmplInterface::set_streaming(int _streaming) { streaming = _streaming; }
+
+inline void AmplInterface::set_simpl_budget(double budget) { simpl_budget = budget; }
+
+inline void AmplInterface::set_presolve(int _presolve)  { presolve = _presolve; }
+
+inline void AmplInterface::set_decompose(int _decompose)  { decompose = _decompose; }
+
+inline void AmplInterface::set_blocks(int _blocks)  { blocks = _blocks; }
+
+inline void AmplInterface::set_first_sol(int _first_sol)  { first_sol = _first_sol; }
+
+inline void AmplInterface::set_warm_start(int _warm_start)  { warm_start = _warm_start; }
+
+inline void AmplInterface::set_start_priority(int _start_priority)  { start_priority = _start_priority; }
+
 } /* end namespace ibex */
 
 
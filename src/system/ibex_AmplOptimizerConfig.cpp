@@ -0,0 +1,135 @@
+//============================================================================
+//                                  I B E X
+// File        : ibex_AmplOptimizerConfig.cpp
+// Author      : Jordan Ninin
+// License     : See the LICENSE file
+// Created     : Oct 14, 2026
+// Last Update : Oct 17, 2026
+//============================================================================
+
+#include "ibex_AmplOptimizerConfig.h"
+#include "ibex_AmplInterface.h"
+#include "ibex_CtcBlocks.h"
+#include "ibex_CellBufferStart.h"
+
+#include <cmath>
+
+namespace ibex {
+
+namespace {
+
+// Radius of the neighbourhood of the initial point where the loup finder
+// looks for a better point (relative to 1+|x_i|)
+const double WARM_START_RADIUS = 1e-2;
+
+}
+
+AmplOptimizerConfig::AmplOptimizerConfig(const System& sys, const AmplInterface& ampl) :
+		DefaultOptimizerConfig(sys), sys(sys), ampl(ampl), nb_model_var(sys.nb_var),
+		ctc_blocks(NULL), ctc(NULL), buffer_start(NULL) {
+
+}
+
+AmplOptimizerConfig::AmplOptimizerConfig(const System& sub, const AmplInterface& ampl, const System& sys, int k) :
+		DefaultOptimizerConfig(sub), sys(sub), ampl(ampl),
+		vars(ampl.get_component_vars(k)), ctrs(ampl.get_component_ctrs(sys, k)), nb_model_var(sys.nb_var),
+		ctc_blocks(NULL), ctc(NULL), buffer_start(NULL) {
+
+}
+
+AmplOptimizerConfig::~AmplOptimizerConfig() {
+	if (ctc_blocks) {
+		delete ctc;
+		delete ctc_blocks;
+	}
+	delete buffer_start;
+}
+
+Ctc& AmplOptimizerConfig::get_ctc() {
+	if (ctc) return *ctc;
+
+	Ctc& ctc_default = DefaultOptimizerConfig::get_ctc();
+
+	if (ampl.get_nb_blocks()>0) {
+		// the boxes of the optimizer have an extra variable (the objective)
+		ctc_blocks = new CtcBlocks(sys, ampl, get_eps_h(), ctc_default.nb_var, vars, ctrs);
+		ctc = new CtcCompo(*ctc_blocks, ctc_default);
+	} else
+		ctc = &ctc_default;
+
+	return *ctc;
+}
+
+CellBufferOptim& AmplOptimizerConfig::get_cell_buffer() {
+	if (buffer_start) return *buffer_start;
+
+	CellBufferOptim& buffer = DefaultOptimizerConfig::get_cell_buffer();
+
+	Vector x0(sys.nb_var);
+	if (!sys.goal || ampl.get_start_priority()<=0 || !model_point(true, x0))
+		return buffer;
+
+	buffer_start = new CellBufferStart(buffer, x0, goal_var(), ampl.get_start_priority());
+	return *buffer_start;
+}
+
+bool AmplOptimizerConfig::model_point(bool start, Vector& x) const {
+	if (vars.empty())
+		return start ? ampl.get_start_point(x) : ampl.get_x0(x);
+
+	Vector y(nb_model_var);
+	if (!(start ? ampl.get_start_point(y) : ampl.get_x0(y))) return false;
+	for (size_t j = 0; j < vars.size(); j++)
+		x[j] = y[vars[j]];
+	return true;
+}
+
+bool AmplOptimizerConfig::feasible(const Vector& x) const {
+	if (!sys.box.contains(x)) return false;
+	if (sys.nb_ctr==0) return true;
+
+	IntervalVector fx = sys.f_ctrs.eval_vector(IntervalVector(x));
+	for (int c = 0; c < sys.nb_ctr; c++) {
+		switch (sys.ctrs[c].op) {
+		case LT:  if (!(fx[c].ub() < 0)) return false; break;
+		case LEQ: if (!(fx[c].ub() <= 0)) return false; break;
+		case EQ:  if (with_rigor() || !fx[c].is_subset(Interval(-get_eps_h(), get_eps_h()))) return false; break;
+		case GEQ: if (!(fx[c].lb() >= 0)) return false; break;
+		case GT:  if (!(fx[c].lb() > 0)) return false; break;
+		}
+	}
+	return true;
+}
+
+bool AmplOptimizerConfig::warm_start(Vector& x, double& loup) {
+	if (!sys.goal || ampl.get_warm_start()!=1) return false;
+
+	Vector x0(sys.nb_var);
+	if (!model_point(false, x0)) return false;
+
+	loup = POS_INFINITY;
+	if (feasible(x0)) {
+		x = x0;
+		loup = sys.goal->eval(IntervalVector(x0)).ub();
+	}
+
+	// a short local improvement
+	IntervalVector box(sys.nb_var);
+	for (int i = 0; i < sys.nb_var; i++)
+		box[i] = x0[i] + WARM_START_RADIUS*(1+fabs(x0[i]))*Interval(-1,1);
+	box &= sys.box;
+
+	if (!box.is_empty()) {
+		try {
+			std::pair<IntervalVector, double> p = get_loup_finder().find(box, IntervalVector(loup<POS_INFINITY ? x : x0), loup);
+			if (p.second < loup) {
+				x = p.first.mid();
+				loup = p.second;
+			}
+		} catch (LoupFinder::NotFound&) { }
+	}
+
+	return loup < POS_INFINITY;
+}
+
+} /* end namespace ibex */
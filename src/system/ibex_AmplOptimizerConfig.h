@@ -0,0 +1,110 @@
+//============================================================================
+//                                  I B E X
+// File        : ibex_AmplOptimizerConfig.h
+// Author      : Jordan Ninin
+// License     : See the LICENSE file
+// Created     : Oct 14, 2026
+// Last Update : Oct 17, 2026
+//============================================================================
+
+#ifndef __IBEX_AMPL_OPTIMIZER_CONFIG_H__
+#define __IBEX_AMPL_OPTIMIZER_CONFIG_H__
+
+#include "ibex.h"
+
+namespace ibex {
+
+class AmplInterface;
+class CtcBlocks;
+class CellBufferStart;
+
+/**
+ * \brief Default configuration of the optimizer for an AMPL model.
+ *
+ * Same as DefaultOptimizerConfig, plus the components built from the
+ * structure of the model found by AmplInterface:
+ * * the blocks of equations are contracted by interval Newton before the
+ *   default contractor (see AmplInterface::set_blocks()).
+ * * the initial point of the model gives a first upper bound of the
+ *   objective (see #warm_start()).
+ * * the boxes containing the start point are explored first at the
+ *   beginning of the search (see AmplInterface::set_start_priority()).
+ */
+class AmplOptimizerConfig : public DefaultOptimizerConfig {
+public:
+
+	/**
+	 * \brief Create the configuration of the system sys built from ampl.
+	 *
+	 * Both must outlive this object.
+	 */
+	AmplOptimizerConfig(const System& sys, const AmplInterface& ampl);
+
+	/**
+	 * \brief Create the configuration of the k-th subproblem sub of the
+	 * system sys built from ampl (see AmplInterface::get_component_system()).
+	 *
+	 * The blocks of equations, the start point and the initial point are
+	 * restricted to the subproblem. All must outlive this object.
+	 */
+	AmplOptimizerConfig(const System& sub, const AmplInterface& ampl, const System& sys, int k);
+
+	/**
+	 * \brief Delete this.
+	 */
+	virtual ~AmplOptimizerConfig();
+
+	/**
+	 * \brief The contractor.
+	 */
+	virtual Ctc& get_ctc();
+
+	/**
+	 * \brief The buffer of cells.
+	 */
+	virtual CellBufferOptim& get_cell_buffer();
+
+	/**
+	 * \brief Warm start from the initial point of the AMPL model.
+	 *
+	 * The initial point (see AmplInterface::get_x0()) is kept if it is in
+	 * the box and satisfies the constraints (the equalities up to eps_h,
+	 * and not in rigor mode). The loup finder then looks for a better point
+	 * in a small neighbourhood.
+	 *
+	 * \param x    - (output) the best feasible point found.
+	 * \param loup - (output) an upper bound of the objective at x.
+	 * \return false if no feasible point is found, if the model has no
+	 *         objective or no initial point, or if the warm start is disabled
+	 *         (see AmplInterface::set_warm_start()).
+	 */
+	bool warm_start(Vector& x, double& loup);
+
+private:
+	/** true if x satisfies the constraints of sys */
+	bool feasible(const Vector& x) const;
+
+	/** the start point (or the initial point if start is false) of the
+	 *  model restricted to the variables of sys */
+	bool model_point(bool start, Vector& x) const;
+
+	const System& sys;
+	const AmplInterface& ampl;
+
+	/** the variables and constraints of sys in the system built from
+	 *  ampl, if sys is a subproblem (empty otherwise) */
+	const std::vector<int> vars;
+	const std::vector<int> ctrs;
+
+	/** the number of variables of the system built from ampl */
+	const int nb_model_var;
+
+	CtcBlocks* ctc_blocks;
+	Ctc* ctc;
+
+	CellBufferStart* buffer_start;
+};
+
+} /* end namespace ibex */
+
+#endif /* __IBEX_AMPL_OPTIMIZER_CONFIG_H__ */
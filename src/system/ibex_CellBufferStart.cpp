@@ -0,0 +1,98 @@
+//============================================================================
+//                                  I B E X
+// File        : ibex_CellBufferStart.cpp
+// Author      : Jordan Ninin
+// License     : See the LICENSE file
+// Created     : Oct 16, 2026
+// Last Update : Oct 16, 2026
+//============================================================================
+
+#include "ibex_CellBufferStart.h"
+
+namespace ibex {
+
+CellBufferStart::CellBufferStart(CellBufferOptim& buffer, const Vector& x, int goal_var, int nodes) :
+		buffer(buffer), x(x), goal_var(goal_var), nodes(nodes), popped(0) {
+
+}
+
+CellBufferStart::~CellBufferStart() {
+	for (size_t i = 0; i < cells.size(); i++)
+		delete cells[i];
+}
+
+void CellBufferStart::add_property(const IntervalVector& init_box, BoxProperties& map) {
+	buffer.add_property(init_box, map);
+}
+
+void CellBufferStart::flush() {
+	for (size_t i = 0; i < cells.size(); i++)
+		delete cells[i];
+	cells.clear();
+	buffer.flush();
+}
+
+unsigned int CellBufferStart::size() const {
+	return cells.size() + buffer.size();
+}
+
+bool CellBufferStart::empty() const {
+	return cells.empty() && buffer.empty();
+}
+
+bool CellBufferStart::contains(const Cell& cell) const {
+	for (int i = 0; i < x.size(); i++) {
+		int j = i < goal_var ? i : i+1; // (the objective is not a variable of the point)
+		if (!cell.box[j].contains(x[i])) return false;
+	}
+	return true;
+}
+
+void CellBufferStart::push(Cell* cell) {
+	if (popped < nodes && contains(*cell))
+		cells.push_back(cell);
+	else
+		buffer.push(cell);
+}
+
+Cell* CellBufferStart::pop() {
+	if (cells.empty())
+		return buffer.pop();
+
+	Cell* c = cells.back();
+	cells.pop_back();
+	if (++popped >= nodes) end_phase();
+	return c;
+}
+
+Cell* CellBufferStart::top() const {
+	return cells.empty() ? buffer.top() : cells.back();
+}
+
+double CellBufferStart::minimum() const {
+	double m = buffer.empty() ? POS_INFINITY : buffer.minimum();
+	for (size_t i = 0; i < cells.size(); i++)
+		m = std::min(m, cells[i]->box[goal_var].lb());
+	return m;
+}
+
+void CellBufferStart::contract(double loup) {
+	// (same as the other buffers: the cells whose objective is greater than loup are removed)
+	size_t k = 0;
+	for (size_t i = 0; i < cells.size(); i++) {
+		if (cells[i]->box[goal_var].lb() > loup)
+			delete cells[i];
+		else
+			cells[k++] = cells[i];
+	}
+	cells.resize(k);
+	buffer.contract(loup);
+}
+
+void CellBufferStart::end_phase() {
+	for (size_t i = 0; i < cells.size(); i++)
+		buffer.push(cells[i]);
+	cells.clear();
+}
+
+} /* end namespace ibex */
@@ -0,0 +1,91 @@
+//============================================================================
+//                                  I B E X
+// File        : ibex_CellBufferStart.h
+// Author      : Jordan Ninin
+// License     : See the LICENSE file
+// Created     : Oct 16, 2026
+// Last Update : Oct 16, 2026
+//============================================================================
+
+#ifndef __IBEX_CELL_BUFFER_START_H__
+#define __IBEX_CELL_BUFFER_START_H__
+
+#include "ibex.h"
+
+#include <vector>
+
+namespace ibex {
+
+/**
+ * \brief Buffer of the optimizer exploring the cells that contain a given
+ * point first.
+ *
+ * During the first nodes of the search, the cells that contain the point
+ * (e.g., the initial point of the AMPL model) are popped before the other
+ * ones, so that the search dives towards the point (and finds a first
+ * upper bound quickly). The other cells, and all the cells after this
+ * early phase, are handled by another buffer.
+ */
+class CellBufferStart : public CellBufferOptim {
+public:
+
+	/**
+	 * \brief Create the buffer.
+	 *
+	 * \param buffer   - the buffer of the other cells (must outlive this object).
+	 * \param x        - the point (the first variables of the boxes).
+	 * \param goal_var - index of the objective in the boxes.
+	 * \param nodes    - number of cells popped in priority (early phase).
+	 */
+	CellBufferStart(CellBufferOptim& buffer, const Vector& x, int goal_var, int nodes);
+
+	/**
+	 * \brief Delete this.
+	 */
+	virtual ~CellBufferStart();
+
+	virtual void add_property(const IntervalVector& init_box, BoxProperties& map);
+
+	virtual void flush();
+
+	virtual unsigned int size() const;
+
+	virtual bool empty() const;
+
+	virtual void push(Cell* cell);
+
+	virtual Cell* pop();
+
+	virtual Cell* top() const;
+
+	virtual double minimum() const;
+
+	virtual void contract(double loup);
+
+	/**
+	 * \brief Number of cells popped in priority so far.
+	 */
+	int nb_popped() const;
+
+private:
+	/** true if the box of the cell contains the point */
+	bool contains(const Cell& cell) const;
+
+	/** end of the early phase: the cells are moved to the buffer */
+	void end_phase();
+
+	CellBufferOptim& buffer;
+	const Vector x;
+	const int goal_var;
+	const int nodes;
+
+	/** the cells that contain the point (the last one is popped first) */
+	std::vector<Cell*> cells;
+	int popped;
+};
+
+inline int CellBufferStart::nb_popped() const { return popped; }
+
+} /* end namespace ibex */
+
+#endif /* __IBEX_CELL_BUFFER_START_H__ */
@@ -0,0 +1,120 @@
+//============================================================================
+//                                  I B E X
+// File        : ibex_CtcBlocks.cpp
+// Author      : Jordan Ninin
+// License     : See the LICENSE file
+// Created     : Oct 14, 2026
+// Last Update : Oct 17, 2026
+//============================================================================
+
+#include "ibex_CtcBlocks.h"
+#include "ibex_AmplInterface.h"
+
+#include <map>
+
+namespace ibex {
+
+CtcBlocks::CtcBlocks(const System& sys, const AmplInterface& ampl, double eps_h, int nb_var,
+		const std::vector<int>& sub_vars, const std::vector<int>& sub_ctrs) :
+		Ctc(nb_var<0 ? sys.nb_var : nb_var), sys(sys), eps_h(eps_h) {
+
+	// the position of each variable and constraint in sys (-1 if not in sys)
+	std::map<int,int> var_pos, ctr_pos;
+	for (size_t j = 0; j < sub_vars.size(); j++)
+		var_pos[sub_vars[j]] = j;
+	for (size_t c = 0; c < sub_ctrs.size(); c++)
+		ctr_pos[sub_ctrs[c]] = c;
+	bool sub = !sub_vars.empty();
+
+	for (int b = 0; b < ampl.get_nb_blocks(); b++) {
+		const std::vector<int>& bc = ampl.get_block_ctrs(b);
+		const std::vector<int>& bv = ampl.get_block_vars(b);
+		BitSet c = BitSet::empty(sys.nb_ctr);
+		std::vector<int> v;
+		bool in_sys = true;
+		for (size_t k = 0; in_sys && k < bc.size(); k++) {
+			if (!sub) {
+				c.add(bc[k]);
+				v.push_back(bv[k]);
+			} else if (ctr_pos.count(bc[k]) && var_pos.count(bv[k])) {
+				c.add(ctr_pos[bc[k]]);
+				v.push_back(var_pos[bv[k]]);
+			} else
+				in_sys = false; // a block of another subproblem
+		}
+		if (!in_sys) continue;
+		ctrs.push_back(c);
+		vars.push_back(v);
+	}
+}
+
+void CtcBlocks::contract(IntervalVector& box) {
+	IntervalVector x = box.size()==sys.nb_var ? box : box.subvector(0, sys.nb_var-1);
+
+	for (size_t b = 0; b < vars.size(); b++) {
+		if (!newton(b, x)) {
+			box.set_empty();
+			return;
+		}
+	}
+
+	box.put(0, x);
+}
+
+// The mean value form of the equations f of the block, with respect to its
+// variables y (the other variables p being kept as intervals), gives
+//     f(y,p) in f(m,p) + J(y,p)*(y-m)
+// where m is the midpoint of y. So the solutions satisfy J*(y-m) in
+// [-eps_h,eps_h] - f(m,p), which is preconditioned by the inverse of the
+// midpoint of J and contracted by Gauss-Seidel.
+bool CtcBlocks::newton(int b, IntervalVector& x) {
+	const std::vector<int>& y = vars[b];
+	int n = y.size();
+
+	for (int k = 0; k < n; k++)
+		if (x[y[k]].is_unbounded()) return true; // no midpoint
+
+	IntervalMatrix J(n, sys.nb_var);
+	sys.f_ctrs.jacobian(x, J, ctrs[b]);
+
+	IntervalMatrix A(n, n);
+	for (int i = 0; i < n; i++)
+		for (int k = 0; k < n; k++) {
+			A[i][k] = J[i][y[k]];
+			if (A[i][k].is_unbounded()) return true;
+		}
+
+	IntervalVector m = x;
+	for (int k = 0; k < n; k++)
+		m[y[k]] = x[y[k]].mid();
+
+	IntervalVector rhs = sys.f_ctrs.eval_vector(m, ctrs[b]);
+	for (int i = 0; i < n; i++)
+		rhs[i] = Interval(-eps_h, eps_h) - rhs[i];
+
+	Matrix C(n, n);
+	try {
+		real_inverse(A.mid(), C);
+	} catch (SingularMatrixException&) {
+		return true;
+	}
+
+	IntervalVector d(n);
+	for (int k = 0; k < n; k++)
+		d[k] = x[y[k]] - m[y[k]];
+
+	try {
+		gauss_seidel(C*A, C*rhs, d);
+	} catch (LinearException&) {
+		return true;
+	}
+	if (d.is_empty()) return false;
+
+	for (int k = 0; k < n; k++) {
+		x[y[k]] &= m[y[k]] + d[k];
+		if (x[y[k]].is_empty()) return false;
+	}
+	return true;
+}
+
+} /* end namespace ibex */
@@ -0,0 +1,77 @@
+//============================================================================
+//                                  I B E X
+// File        : ibex_CtcBlocks.h
+// Author      : Jordan Ninin
+// License     : See the LICENSE file
+// Created     : Oct 14, 2026
+// Last Update : Oct 17, 2026
+//============================================================================
+
+#ifndef __IBEX_CTC_BLOCKS_H__
+#define __IBEX_CTC_BLOCKS_H__
+
+#include "ibex.h"
+
+#include <vector>
+
+namespace ibex {
+
+class AmplInterface;
+
+/**
+ * \brief Interval Newton on the blocks of equations of a system.
+ *
+ * The blocks are the square blocks of the block-triangular decomposition
+ * of the equations (see AmplInterface::set_blocks()). They are contracted
+ * in the order of resolution, so that each block benefits from the
+ * contraction of the previous ones. The variables of the system that are
+ * not in a block are parameters of the block (their domains are kept).
+ */
+class CtcBlocks : public Ctc {
+public:
+
+	/**
+	 * \brief Create the contractor of the blocks of sys.
+	 *
+	 * \param sys    - the system built from ampl (must outlive this object).
+	 * \param eps_h  - each equation f(x)=0 is relaxed to f(x) in [-eps_h,eps_h].
+	 * \param nb_var - size of the boxes to contract (the first variables being the
+	 *                 ones of the system), e.g., sys.nb_var+1 in an optimizer
+	 *                 (for the objective). Default: sys.nb_var.
+	 * \param vars, ctrs - if sys is a subproblem of the system built from ampl
+	 *                 (see AmplInterface::get_component_system()), the indices
+	 *                 of its variables and constraints in this system. Only the
+	 *                 blocks of the subproblem are then contracted.
+	 */
+	CtcBlocks(const System& sys, const AmplInterface& ampl, double eps_h=0, int nb_var=-1,
+			const std::vector<int>& vars=std::vector<int>(), const std::vector<int>& ctrs=std::vector<int>());
+
+	/**
+	 * \brief Contract the blocks in order.
+	 */
+	virtual void contract(IntervalVector& box);
+
+	/**
+	 * \brief Number of blocks.
+	 */
+	int nb_blocks() const;
+
+private:
+	/** one step of interval Newton on the b-th block. Returns false if x is empty. */
+	bool newton(int b, IntervalVector& x);
+
+	const System& sys;
+	const double eps_h;
+
+	/** the constraints of each block (as a subset of the components of sys.f_ctrs) */
+	std::vector<BitSet> ctrs;
+
+	/** the variables of each block */
+	std::vector<std::vector<int> > vars;
+};
+
+inline int CtcBlocks::nb_blocks() const { return vars.size(); }
+
+} /* end namespace ibex */
+
+#endif /* __IBEX_CTC_BLOCKS_H__ */
@@ -0,0 +1,151 @@
+//============================================================================
+//                                  I B E X
+// File        : ibex_NlReader.cpp
+// Author      : Jordan Ninin
+// License     : See the LICENSE file
+// Created     : Oct 5, 2026
+// Last Update : Oct 9, 2026
+//============================================================================
+
+#include "ibex_NlReader.h"
+
+#include <stdint.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace ibex {
+
+NlReader::NlReader(const std::string& nlfile, size_t offset) :
+		data(NULL), size(0), first(NULL), cur(NULL), end(NULL), _binary(false), _ok(false), mapped(false) {
+
+#ifndef _WIN32
+	int fd = open(nlfile.c_str(), O_RDONLY);
+	if (fd>=0) {
+		struct stat st;
+		if (fstat(fd, &st)==0 && st.st_size>0) {
+			void* p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (p!=MAP_FAILED) {
+				data = (const char*) p;
+				size = st.st_size;
+				mapped = true;
+				madvise(p, size, MADV_SEQUENTIAL);
+			}
+		}
+		close(fd);
+	}
+#endif
+
+	if (!mapped) {
+		// no memory mapping: the file is read at once
+		std::ifstream f(nlfile.c_str(), std::ios::in | std::ios::binary);
+		if (!f) return;
+		f.seekg(0, std::ios::end);
+		buffer.resize(f.tellg());
+		f.seekg(0, std::ios::beg);
+		if (!buffer.empty()) f.read(&buffer[0], buffer.size());
+		if (!f) return;
+		data = buffer.empty() ? NULL : &buffer[0];
+		size = buffer.size();
+	}
+
+	if (size==0 || offset>size) return;
+
+	switch (data[0]) {
+	case 'g':
+	case 'G': _binary = false;
+	          // a number always ends before the last end of line
+	          _ok = (data[size-1]=='\n');
+	          break;
+	case 'b':
+	case 'B': _binary = true; _ok = true; break;
+	default:  _ok = false; // other formats are left to the ASL
+	}
+
+	first = cur = data + offset;
+	end = data + size;
+}
+
+NlReader::NlReader(const NlReader& r) :
+		data(r.data), size(r.size), first(r.first), cur(r.cur), end(r.end), _binary(r._binary), _ok(r._ok), mapped(false) {
+	// buffer is left empty: the content belongs to r
+}
+
+NlReader::~NlReader() {
+#ifndef _WIN32
+	if (mapped)
+		munmap((void*) data, size);
+#endif
+}
+
+void NlReader::skip_blanks() {
+	while (cur<end && (*cur==' ' || *cur=='\t'))
+		cur++;
+}
+
+char NlReader::read_char() {
+	if (cur>=end) throw Error();
+	return *cur++;
+}
+
+int NlReader::read_int() {
+	if (_binary) {
+		int32_t i;
+		if (end-cur < (long) sizeof(i)) throw Error();
+		memcpy(&i, cur, sizeof(i));
+		cur += sizeof(i);
+		return i;
+	}
+
+	skip_blanks();
+	bool neg = (cur<end && *cur=='-');
+	if (neg) cur++;
+	if (cur>=end || *cur<'0' || *cur>'9') throw Error();
+	int i = 0;
+	while (cur<end && *cur>='0' && *cur<='9')
+		i = 10*i + (*cur++ - '0');
+	return neg ? -i : i;
+}
+
+int NlReader::read_short() {
+	if (_binary) {
+		int16_t i;
+		if (end-cur < (long) sizeof(i)) throw Error();
+		memcpy(&i, cur, sizeof(i));
+		cur += sizeof(i);
+		return i;
+	}
+	return read_int();
+}
+
+double NlReader::read_double() {
+	if (_binary) {
+		double x;
+		if (end-cur < (long) sizeof(x)) throw Error();
+		memcpy(&x, cur, sizeof(x));
+		cur += sizeof(x);
+		return x;
+	}
+
+	skip_blanks();
+	char* next;
+	double x = strtod(cur, &next);
+	if (next==cur) throw Error();
+	cur = next;
+	return x;
+}
+
+void NlReader::next_line() {
+	if (_binary) return;
+	const char* eol = (const char*) memchr(cur, '\n', end-cur);
+	cur = eol ? eol+1 : end;
+}
+
+} /* end namespace ibex */
@@ -0,0 +1,151 @@
+//============================================================================
+//                                  I B E X
+// File        : ibex_NlReader.h
+// Author      : Jordan Ninin
+// License     : See the LICENSE file
+// Created     : Oct 5, 2026
+// Last Update : Oct 9, 2026
+//============================================================================
+
+#ifndef __IBEX_NL_READER_H__
+#define __IBEX_NL_READER_H__
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace ibex {
+
+/**
+ * \brief Reader of the segments of an AMPL .nl file.
+ *
+ * The file is mapped in memory (read-only) and the tokens are decoded
+ * in place, without being copied. Both the text ("g" header) and the
+ * binary ("b" header, native byte order) formats are supported.
+ *
+ * The header of the file is not read here (see jac0dim of the ASL):
+ * the segments start at the offset given to the constructor.
+ */
+class NlReader {
+public:
+
+	/**
+	 * \brief Thrown when the file is malformed (or truncated).
+	 */
+	class Error { };
+
+	/**
+	 * \brief Map the file nlfile.
+	 *
+	 * \param offset - position of the first segment (end of the header).
+	 */
+	NlReader(const std::string& nlfile, size_t offset);
+
+	/**
+	 * \brief Another reader of the same file.
+	 *
+	 * The content of the file is shared (not copied) and must outlive
+	 * this reader: this allows several threads to read the file at
+	 * different positions.
+	 */
+	NlReader(const NlReader& r);
+
+	/**
+	 * \brief Unmap the file.
+	 */
+	~NlReader();
+
+	/**
+	 * \brief True if the file is mapped and its format is supported.
+	 */
+	bool ok() const;
+
+	/**
+	 * \brief True if the file is in binary format.
+	 */
+	bool binary() const;
+
+	/**
+	 * \brief True if all the segments have been read.
+	 */
+	bool at_end() const;
+
+	/**
+	 * \brief Read the letter of a segment or of an expression node
+	 * (in text format, the first character of a line).
+	 */
+	char read_char();
+
+	/**
+	 * \brief Read an integer.
+	 */
+	int read_int();
+
+	/**
+	 * \brief Read a short integer (expression node "s").
+	 */
+	int read_short();
+
+	/**
+	 * \brief Read a real number.
+	 */
+	double read_double();
+
+	/**
+	 * \brief Skip the end of the current line (text format only).
+	 */
+	void next_line();
+
+	/**
+	 * \brief Go back to the first segment.
+	 */
+	void rewind();
+
+	/**
+	 * \brief Current position in the file.
+	 */
+	size_t pos() const;
+
+	/**
+	 * \brief Go to a position returned by #pos().
+	 */
+	void seek(size_t pos);
+
+private:
+	/** Skip blanks (text format). */
+	void skip_blanks();
+
+	/** The mapped file. */
+	const char* data;
+	size_t size;
+
+	/** First segment, current position and end of the file. */
+	const char* first;
+	const char* cur;
+	const char* end;
+
+	bool _binary;
+	bool _ok;
+
+	NlReader& operator=(const NlReader&); // forbidden
+
+	/** Content of the file when it cannot be mapped. */
+	std::vector<char> buffer;
+	bool mapped;
+};
+
+inline bool NlReader::ok() const     { return _ok; }
+
+inline bool NlReader::binary() const { return _binary; }
+
+inline bool NlReader::at_end() const { return cur>=end; }
+
+inline void NlReader::rewind()       { cur = first; }
+
+inline size_t NlReader::pos() const  { return cur-data; }
+
+inline void NlReader::seek(size_t pos) { cur = data+pos; }
+
+} /* end namespace ibex */
+
+#endif /* __IBEX_NL_READER_H__ */
@@ -0,0 +1,55 @@
+//============================================================================
+//                                  I B E X
+// File        : ibex_NodeTable.cpp
+// Author      : Jordan Ninin
+// License     : See the LICENSE file
+// Created     : Oct 10, 2026
+// Last Update : Oct 17, 2026
+//============================================================================
+
+#include "ibex_NodeTable.h"
+
+#include <cstring>
+
+namespace ibex {
+
+namespace {
+
+// initial number of slots
+const size_t MIN_SLOTS = 1024;
+
+}
+
+NodeTable::NodeTable() : allocs(0) {
+
+}
+
+size_t NodeTable::hash(size_t op, double cst) {
+	size_t h = op;
+	cst += 0.0; // -0 and +0 are equal, so they must have the same hash code
+	unsigned char p[sizeof(double)];
+	memcpy(p, &cst, sizeof(double));
+	for (size_t i=0; i<sizeof(double); i++)
+		h = h*31 + p[i];
+	return h;
+}
+
+void NodeTable::rehash() {
+	size_t nb = slots.empty() ? MIN_SLOTS : 2*slots.size();
+	slots.assign(nb, 0);
+	allocs++;
+	size_t mask = nb-1;
+	for (size_t i=0; i<entries.size(); i++) {
+		size_t s = entries[i].hash & mask;
+		while (slots[s]) s = (s+1) & mask;
+		slots[s] = i+1;
+	}
+}
+
+void NodeTable::clear() {
+	std::vector<Entry>().swap(entries);
+	std::vector<size_t>().swap(args);
+	std::vector<size_t>().swap(slots);
+}
+
+} /* end namespace ibex */
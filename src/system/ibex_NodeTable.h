@@ -0,0 +1,182 @@
+//============================================================================
+//                                  I B E X
+// File        : ibex_NodeTable.h
+// Author      : Jordan Ninin
+// License     : See the LICENSE file
+// Created     : Oct 10, 2026
+// Last Update : Oct 17, 2026
+//============================================================================
+
+#ifndef __IBEX_NODE_TABLE_H__
+#define __IBEX_NODE_TABLE_H__
+
+#include <vector>
+#include <cstddef>
+
+namespace ibex {
+
+class ExprNode;
+
+/**
+ * \brief Hash-consing table of the nodes built by AmplInterface.
+ *
+ * A node is identified by a key: its operator, a constant (exponent,
+ * value of a number, etc.) and its operands. An operand is given by any
+ * structure with a node "e" and a flag "neg" (the node is subtracted).
+ *
+ * The table is stored in a few flat arrays (open addressing): the
+ * entries and the operands of all the keys are appended to two arenas,
+ * so that an insertion does not allocate memory (except when an array
+ * grows). All the memory is released at once by #clear().
+ */
+class NodeTable {
+public:
+
+	/**
+	 * \brief Create an empty table.
+	 */
+	NodeTable();
+
+	/**
+	 * \brief The node of key (op, cst, t[0..n-1]), NULL if there is none.
+	 */
+	template<class T>
+	const ExprNode* find(size_t op, double cst, const T* t, size_t n) const;
+
+	/**
+	 * \brief Insert the node e of key (op, cst, t[0..n-1]).
+	 *
+	 * The key must not be in the table.
+	 */
+	template<class T>
+	void insert(size_t op, double cst, const T* t, size_t n, const ExprNode* e);
+
+	/**
+	 * \brief Number of nodes.
+	 */
+	size_t size() const;
+
+	/**
+	 * \brief Remove all the nodes and release the memory.
+	 */
+	void clear();
+
+	/**
+	 * \brief Number of times an array of the table has been (re)allocated.
+	 */
+	long nb_allocs() const;
+
+private:
+	struct Entry {
+		size_t hash;
+		size_t op;
+		double cst;
+		size_t first;           // position of the operands in args
+		size_t n;               // number of operands
+		const ExprNode* node;
+	};
+
+	/** an operand encoded as an integer (the address of its node,
+	 *  the lowest bit being set if it is subtracted) */
+	template<class T>
+	static size_t operand(const T& t);
+
+	/** hash code of the operator and the constant */
+	static size_t hash(size_t op, double cst);
+
+	template<class T>
+	static size_t hash(size_t op, double cst, const T* t, size_t n);
+
+	/** index of the slot of the key (empty if not found) */
+	template<class T>
+	size_t slot(size_t h, size_t op, double cst, const T* t, size_t n) const;
+
+	/** double the number of slots */
+	void rehash();
+
+	/** appends x to v, counting the reallocations */
+	template<class X>
+	void push(std::vector<X>& v, const X& x);
+
+	/** the entries, in order of insertion */
+	std::vector<Entry> entries;
+
+	/** the operands of all the keys */
+	std::vector<size_t> args;
+
+	/** 1 + the index of an entry, 0 for an empty slot (power of 2 size) */
+	std::vector<size_t> slots;
+
+	long allocs;
+};
+
+/*================================== inline implementations ========================================*/
+
+template<class T>
+inline size_t NodeTable::operand(const T& t) {
+	return ((size_t) t.e) | (t.neg ? 1 : 0);
+}
+
+template<class T>
+size_t NodeTable::hash(size_t op, double cst, const T* t, size_t n) {
+	size_t h = hash(op, cst);
+	for (size_t i=0; i<n; i++)
+		h = (h*1000003) ^ operand(t[i]);
+	return h;
+}
+
+template<class T>
+size_t NodeTable::slot(size_t h, size_t op, double cst, const T* t, size_t n) const {
+	size_t mask = slots.size()-1;
+	// linear probing
+	for (size_t s = h & mask; ; s = (s+1) & mask) {
+		if (!slots[s]) return s;
+		const Entry& e = entries[slots[s]-1];
+		if (e.hash!=h || e.op!=op || e.cst!=cst || e.n!=n) continue;
+		size_t i=0;
+		while (i<n && args[e.first+i]==operand(t[i])) i++;
+		if (i==n) return s;
+	}
+}
+
+template<class T>
+const ExprNode* NodeTable::find(size_t op, double cst, const T* t, size_t n) const {
+	if (slots.empty()) return NULL;
+	size_t s = slot(hash(op, cst, t, n), op, cst, t, n);
+	return slots[s] ? entries[slots[s]-1].node : NULL;
+}
+
+template<class T>
+void NodeTable::insert(size_t op, double cst, const T* t, size_t n, const ExprNode* node) {
+	// load factor <= 1/2
+	if (2*(entries.size()+1) > slots.size())
+		rehash();
+
+	Entry e;
+	e.hash = hash(op, cst, t, n);
+	e.op = op;
+	e.cst = cst;
+	e.first = args.size();
+	e.n = n;
+	e.node = node;
+
+	for (size_t i=0; i<n; i++)
+		push(args, operand(t[i]));
+	push(entries, e);
+
+	slots[slot(e.hash, op, cst, t, n)] = entries.size();
+}
+
+template<class X>
+inline void NodeTable::push(std::vector<X>& v, const X& x) {
+	if (v.size()==v.capacity()) allocs++;
+	v.push_back(x);
+}
+
+inline size_t NodeTable::size() const  { return entries.size(); }
+
+inline long NodeTable::nb_allocs() const { return allocs; }
+
+} /* end namespace ibex */
+
+#endif /* __IBEX_NODE_TABLE_H__ */
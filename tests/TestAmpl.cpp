@@ -10,17 +10,265 @@
  * ---------------------------------------------------------------------------- */
 
 #include "TestAmpl.h"
+#include "ampl_ref.h"
 #include "ibex_AmplInterface.h"
+#include "ibex_CtcBlocks.h"
+#include "ibex_AmplOptimizerConfig.h"
+#include "ibex_CellBufferStart.h"
 #include "ibex_ExtendedSystem.h"
 #include "ibex_NormalizedSystem.h"
 #include "ibex_DefaultOptimizerConfig.h"
+#include "ibex_Optimizer.h"
+#include "ibex_CovOptimData.h"
 
 #include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <climits>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 
 using namespace std;
 
 namespace ibex {
 
+namespace {
+
+// Writes a text .nl file with nb_var variables in [-1,1], no objective and
+// the nb_ctr constraints (the large synthetic models; the small ones are
+// in ex_ampl/)
+//     sum_{k<nb_terms} x[(i+k)%nb_var]^2 + sum_{j<nb_lin} (j+1)*x[j] <= nb_terms.
+void write_nl(const char* nlfile, int nb_var, int nb_ctr, int nb_terms, int nb_lin=0) {
+	// the coefficients of the Jacobian (0 for the nonlinear part)
+	vector<map<int,double> > jac(nb_ctr);
+	vector<int> col(nb_var,0);
+	int nnz=0;
+	for (int i=0; i<nb_ctr; i++) {
+		for (int k=0; k<nb_terms && k<nb_var; k++)
+			jac[i][(i+k)%nb_var] = 0;
+		for (int j=0; j<nb_lin; j++)
+			jac[i][j] = j+1;
+		for (map<int,double>::const_iterator it=jac[i].begin(); it!=jac[i].end(); ++it)
+			col[it->first]++;
+		nnz += jac[i].size();
+	}
+	// the nonlinear variables come first
+	int nb_nl_var = nb_terms>0 ? std::min(nb_var, nb_ctr+nb_terms-1) : 0;
+
+	ofstream f(nlfile);
+	f << "g3 1 1 0\t# problem synthetic\n";
+	f << " " << nb_var << " " << nb_ctr << " 0 0 0\t# vars, constraints, objectives, ranges, eqns\n";
+	f << " " << (nb_terms>0 ? nb_ctr : 0) << " 0\t# nonlinear constraints, objectives\n";
+	f << " 0 0\t# network constraints: nonlinear, linear\n";
+	f << " " << nb_nl_var << " 0 0\t# nonlinear vars in constraints, objectives, both\n";
+	f << " 0 0 0 1\t# linear network variables; functions; arith, flags\n";
+	f << " 0 0 0 0 0\t# discrete variables: binary, integer, nonlinear (b,c,o)\n";
+	f << " " << nnz << " 0\t# nonzeros in Jacobian, gradients\n";
+	f << " 0 0\t# max name lengths: constraints, variables\n";
+	f << " 0 0 0 0 0\t# common exprs: b,c,o,c1,o1\n";
+	for (int i=0; i<nb_ctr; i++) {
+		f << "C" << i << "\n";
+		if (nb_terms==0)
+			f << "n0\n";
+		else if (nb_terms>1)
+			f << "o54\n" << nb_terms << "\n";
+		for (int k=0; k<nb_terms; k++)
+			f << "o5\nv" << (i+k)%nb_var << "\nn2\n";
+	}
+	f << "r\n";
+	for (int i=0; i<nb_ctr; i++)
+		f << "1 " << nb_terms << "\n";
+	f << "b\n";
+	for (int j=0; j<nb_var; j++)
+		f << "0 -1 1\n";
+	f << "k" << nb_var-1 << "\n";
+	for (int j=0, sum=0; j<nb_var-1; j++)
+		f << (sum+=col[j]) << "\n";
+	for (int i=0; i<nb_ctr; i++) {
+		f << "J" << i << " " << jac[i].size() << "\n";
+		for (map<int,double>::const_iterator it=jac[i].begin(); it!=jac[i].end(); ++it)
+			f << it->first << " " << it->second << "\n";
+	}
+}
+
+// Writes a text .nl file with nb_ctr variables in [-1,1], no objective and
+// the nb_ctr constraints x[i] + (1 + ... + 1) <= nb_numbers+1, the sum having
+// nb_numbers terms (a large model, translated into a small system).
+void write_nl_numbers(const char* nlfile, int nb_ctr, int nb_numbers) {
+	ofstream f(nlfile);
+	f << "g3 1 1 0\t# problem numbers\n";
+	f << " " << nb_ctr << " " << nb_ctr << " 0 0 0\t# vars, constraints, objectives, ranges, eqns\n";
+	f << " " << nb_ctr << " 0\t# nonlinear constraints, objectives\n";
+	f << " 0 0\t# network constraints: nonlinear, linear\n";
+	f << " " << nb_ctr << " 0 0\t# nonlinear vars in constraints, objectives, both\n";
+	f << " 0 0 0 1\t# linear network variables; functions; arith, flags\n";
+	f << " 0 0 0 0 0\t# discrete variables: binary, integer, nonlinear (b,c,o)\n";
+	f << " " << nb_ctr << " 0\t# nonzeros in Jacobian, gradients\n";
+	f << " 0 0\t# max name lengths: constraints, variables\n";
+	f << " 0 0 0 0 0\t# common exprs: b,c,o,c1,o1\n";
+	for (int i=0; i<nb_ctr; i++) {
+		f << "C" << i << "\no0\nv" << i << "\no54\n" << nb_numbers << "\n";
+		for (int k=0; k<nb_numbers; k++)
+			f << "n1\n";
+	}
+	f << "r\n";
+	for (int i=0; i<nb_ctr; i++)
+		f << "1 " << nb_numbers+1 << "\n";
+	f << "b\n";
+	for (int j=0; j<nb_ctr; j++)
+		f << "0 -1 1\n";
+	f << "k" << nb_ctr-1 << "\n";
+	for (int j=0; j<nb_ctr-1; j++)
+		f << j+1 << "\n";
+	for (int i=0; i<nb_ctr; i++)
+		f << "J" << i << " 1\n" << i << " 0\n";
+}
+
+// The value (in kB) of a field of /proc/self/status, e.g. "VmRSS:".
+long status_kb(const char* field) {
+	std::ifstream f("/proc/self/status");
+	std::string line;
+	while (std::getline(f, line))
+		if (line.compare(0, strlen(field), field)==0)
+			return atol(line.c_str()+strlen(field));
+	return -1;
+}
+
+// The growth of the resident memory (in kB) at its peak, while a child process
+// reads the .nl file with the given options and builds the system: the peak
+// is reset first (see clear_refs in proc(5)). Returns -1 if it cannot be reset
+// and LONG_MAX if the child fails.
+long peak_rss(const char* nlfile, const char* options) {
+	int fd[2];
+	if (pipe(fd)!=0) return -1;
+	pid_t pid=fork();
+	if (pid==0) {
+		close(fd[0]);
+		long res=-1;
+#ifdef __GLIBC__
+		// the free memory of the parent would be reused without growing
+		malloc_trim(0);
+#endif
+		FILE* clear=fopen("/proc/self/clear_refs", "w");
+		if (clear && fputs("5", clear)>=0 && fclose(clear)==0) {
+			long rss0=status_kb("VmRSS:");
+			set_options(options);
+			AmplInterface inter(nlfile);
+			System sys(inter);
+			res=status_kb("VmHWM:")-rss0;
+		}
+		if (write(fd[1], &res, sizeof(res))!=sizeof(res)) _exit(1);
+		_exit(0);
+	}
+	close(fd[1]);
+	long res=LONG_MAX;
+	if (pid<0 || read(fd[0], &res, sizeof(res))!=sizeof(res)) res=LONG_MAX;
+	close(fd[0]);
+	if (pid>0) waitpid(pid, NULL, 0);
+	return res;
+}
+
+// A file in a new temporary directory. The directory and the files
+// in it (e.g., the .sol file written next to a .nl file) are removed
+// by the destructor, even if an assertion fails.
+class TmpFile {
+public:
+	explicit TmpFile(const char* name) {
+		char tmpl[] = "/tmp/ibex_amplXXXXXX";
+		if (!mkdtemp(tmpl)) ibex_error("TmpFile: cannot create a temporary directory");
+		dir = tmpl;
+		path = dir + "/" + name;
+	}
+
+	~TmpFile() {
+		DIR* d = opendir(dir.c_str());
+		if (d) {
+			for (struct dirent* e=readdir(d); e!=NULL; e=readdir(d))
+				if (strcmp(e->d_name,".")!=0 && strcmp(e->d_name,"..")!=0)
+					std::remove((dir + "/" + e->d_name).c_str());
+			closedir(d);
+		}
+		rmdir(dir.c_str());
+	}
+
+	const char* c_str() const { return path.c_str(); }
+
+	std::string dir, path;
+
+private:
+	TmpFile(const TmpFile&);
+};
+
+// A buffer of cells in LIFO order, the objective being the last variable
+// (to check the order of CellBufferStart).
+class CellStack : public CellBufferOptim {
+public:
+	~CellStack()                    { flush(); }
+	void flush()                    { while (!cells.empty()) delete pop(); }
+	unsigned int size() const       { return cells.size(); }
+	bool empty() const              { return cells.empty(); }
+	void push(Cell* cell)           { cells.push_back(cell); }
+	Cell* pop()                     { Cell* c=cells.back(); cells.pop_back(); return c; }
+	Cell* top() const               { return cells.back(); }
+	double minimum() const {
+		double m=POS_INFINITY;
+		for (size_t i=0; i<cells.size(); i++) m=std::min(m, cells[i]->box[cells[i]->box.size()-1].lb());
+		return m;
+	}
+	void contract(double loup) { }
+
+	std::vector<Cell*> cells;
+};
+
+// A cell of the box [x0]x[x1]x[0,f]
+Cell* start_cell(const Interval& x0, const Interval& x1, double f) {
+	IntervalVector box(3);
+	box[0]=x0;
+	box[1]=x1;
+	box[2]=Interval(0,f);
+	return new Cell(box);
+}
+
+// Sets the solver options read by AmplInterface (NULL to clear them).
+void set_options(const char* options) {
+	if (options)
+		setenv("ibexopt_options", options, 1);
+	else
+		unsetenv("ibexopt_options");
+}
+
+// Runs ibexopt with the given arguments on a copy of a .nl file of
+// ex_ampl/ (ibexopt writes the .sol file next to the .nl file).
+int run_ibexopt(const TmpFile& nl, const char* name, const char* args) {
+	std::ifstream in((std::string(SRCDIR_TESTS "/ex_ampl/") + name).c_str());
+	std::ofstream out(nl.c_str());
+	out << in.rdbuf();
+	out.close();
+	return system((std::string(IBEXOPT) + " " + nl.path + " " + args + " > /dev/null").c_str());
+}
+
+// True if the point satisfies the constraints of the system, up to eps.
+bool satisfies(const System& sys, const Vector& x, double eps) {
+	for (int i=0; i<sys.nb_ctr; i++) {
+		Interval v=sys.ctrs[i].f.eval(IntervalVector(x));
+		switch (sys.ctrs[i].op) {
+		case LT: case LEQ: if (v.lb()>eps) return false; break;
+		case GT: case GEQ: if (v.ub()<-eps) return false; break;
+		default:           if (v.lb()>eps || v.ub()<-eps) return false; break;
+		}
+	}
+	return true;
+}
+
+}
+
 
 void TestAmpl::factory01() {
 
@@ -298,5 +546,840 @@ void TestAmpl::option2() {
 //	CPPUNIT_ASSERT(inter.option.trace==3 );
 }
 
+void TestAmpl::large_sum() {
+	// The translation must not overflow the C stack
+	// (see "bench_ampl --scaling" for the loading time).
+	TmpFile nl("large_sum.nl");
+	write_nl(nl.c_str(), 10, 1, 1000000);
+
+	// The sum is a balanced tree: its height is logarithmic
+	// (no symbolic simplification, which would rebuild the sum).
+	{
+		AmplInterface inter(nl.path);
+		inter.set_simplification_level(0);
+		System sys(inter);
+		CPPUNIT_ASSERT(sys.nb_ctr==1);
+		CPPUNIT_ASSERT(sys.ctrs[0].f.expr().height < 30);
+		check(sys.ctrs[0].f.eval(IntervalVector(10,Interval(1))), Interval(0));
+	}
+}
+
+void TestAmpl::baseline_trees() {
+	// the trees are the ones of the original (recursive) translator
+	const char* files[] = { "ex3", "ex7" };
+	for (int k=0; k<2; k++) {
+		string nlfile = string(SRCDIR_TESTS "/ex_ampl/") + files[k] + ".nl";
+		vector<string> ref = ref_ctr_bodies(nlfile.c_str());
+		AmplInterface inter(nlfile);
+		CPPUNIT_ASSERT((int) ref.size()==inter.get_nb_ampl_ctr());
+		for (int i=0; i<inter.get_nb_ampl_ctr(); i++)
+			CPPUNIT_ASSERT(sameExpr(inter.get_ctr_expr(i), ref[i].c_str()));
+	}
+}
+
+void TestAmpl::linear_form() {
+	TmpFile nl("linear_form.nl");
+	write_nl(nl.c_str(), 5000, 1, 0, 5000);
+
+	AmplInterface inter1(nl.path);
+	set_options("linear_form=1");
+	AmplInterface inter2(nl.path);
+	set_options(NULL);
+	CPPUNIT_ASSERT(inter1.get_linear_form()==0);
+	CPPUNIT_ASSERT(inter2.get_linear_form()==1);
+
+	inter1.set_simplification_level(0);
+	inter2.set_simplification_level(0);
+	System sys1(inter1);
+	System sys2(inter2);
+
+	// a product and an addition per term vs. a single dot product
+	CPPUNIT_ASSERT(sys1.ctrs[0].f.expr().size > 10000);
+	CPPUNIT_ASSERT(sys2.ctrs[0].f.expr().size < 10);
+
+	IntervalVector box(5000, Interval(0.5,1));
+	check(sys2.ctrs[0].f.eval(box), sys1.ctrs[0].f.eval(box), 1e-6);
+
+	// same values on a model with nonlinear parts
+	AmplInterface inter3(SRCDIR_TESTS "/ex_ampl/ex7.nl");
+	set_options("linear_form=1");
+	AmplInterface inter4(SRCDIR_TESTS "/ex_ampl/ex7.nl");
+	set_options(NULL);
+	System sys3(inter3);
+	System sys4(inter4);
+	CPPUNIT_ASSERT(sys3.nb_ctr==sys4.nb_ctr);
+	IntervalVector x(sys3.box.mid());
+	check_relatif(sys4.f_ctrs.eval_vector(x), sys3.f_ctrs.eval_vector(x), 1e-6);
+}
+
+void TestAmpl::sharing() {
+	// x6^7, x10^7, x6^4 and x5^4 appear in two constraints of ex8
+	AmplInterface inter(SRCDIR_TESTS "/ex_ampl/ex8.nl");
+	CPPUNIT_ASSERT(inter.get_sharing_ratio()>0);
+	CPPUNIT_ASSERT(inter.get_sharing_ratio()<1);
+
+	System sys(inter);
+	CPPUNIT_ASSERT(sys.nb_ctr==11);
+
+	// con2 and con4 (that share x6^7) at x=1
+	IntervalVector x(13, Interval(1));
+	check(sys.ctrs[1].f.eval(x), Interval(1-0.16275+1-0.37842), 1e-9);
+	check(sys.ctrs[3].f.eval(x), Interval(1-0.15585+1-0.19807), 1e-9);
+}
+
+
+void TestAmpl::nl_reader() {
+	// same model with the ASL and with the native reader
+	const char* files[] = { "ex1", "ex2", "ex3", "ex4", "ex5", "ex6", "ex7", "ex8" };
+	for (int k=0; k<8; k++) {
+		string nlfile = string(SRCDIR_TESTS "/ex_ampl/") + files[k] + ".nl";
+		AmplInterface inter1(nlfile);
+		set_options("nl_reader=1");
+		AmplInterface inter2(nlfile);
+		set_options(NULL);
+		CPPUNIT_ASSERT(inter1.get_nl_reader()==0);
+		CPPUNIT_ASSERT(inter2.get_nl_reader()==1);
+
+		System sys1(inter1);
+		System sys2(inter2);
+		CPPUNIT_ASSERT(sys1.nb_var==sys2.nb_var);
+		CPPUNIT_ASSERT(sys1.nb_ctr==sys2.nb_ctr);
+		CPPUNIT_ASSERT(sys1.box==sys2.box);
+		CPPUNIT_ASSERT((sys1.goal==NULL)==(sys2.goal==NULL));
+		for (int i=0; i<sys1.nb_ctr; i++)
+			CPPUNIT_ASSERT(sys1.ops[i]==sys2.ops[i]);
+
+		IntervalVector box(sys1.box);
+		box &= IntervalVector(sys1.nb_var, Interval(-10,10));
+		IntervalVector x(box.mid());
+		if (sys1.nb_ctr>0)
+			check_relatif(sys2.f_ctrs.eval_vector(x), sys1.f_ctrs.eval_vector(x), 1e-6);
+		if (sys1.goal)
+			check_relatif(sys2.goal->eval(x), sys1.goal->eval(x), 1e-6);
+	}
+
+	// large model
+	TmpFile nl("nl_reader.nl");
+	write_nl(nl.c_str(), 10, 1, 100000);
+	set_options("nl_reader=1");
+	{
+		AmplInterface inter(nl.path);
+		CPPUNIT_ASSERT(inter.get_nl_reader()==1);
+		System sys(inter);
+		CPPUNIT_ASSERT(sys.nb_ctr==1);
+		check(sys.ctrs[0].f.eval(IntervalVector(10,Interval(1))), Interval(0));
+	}
+	set_options(NULL);
+
+	// the defined variable of C0 (x0^2) is defined after it: the native
+	// reader fails while building the model and the ASL reads it instead
+	set_options("nl_reader=1");
+	AmplInterface inter(SRCDIR_TESTS "/ex_ampl/nl_fallback.nl");
+	set_options(NULL);
+	CPPUNIT_ASSERT(inter.get_nl_reader()==0);
+	System sys(inter);
+	CPPUNIT_ASSERT(sys.nb_ctr==1);
+	check(sys.ctrs[0].f.eval(IntervalVector(1,Interval(0.5))), Interval(0.25-1));
+}
+
+
+void TestAmpl::nl_threads() {
+	// same model read sequentially and by several threads
+	const char* files[] = { "ex5", "ex6", "ex7", "ex8" };
+	for (int k=0; k<4; k++) {
+		string nlfile = string(SRCDIR_TESTS "/ex_ampl/") + files[k] + ".nl";
+		set_options("nl_reader=1");
+		AmplInterface inter1(nlfile);
+		set_options("nl_reader=1 nl_threads=4");
+		AmplInterface inter2(nlfile);
+		set_options(NULL);
+		CPPUNIT_ASSERT(inter1.get_nl_threads()==1);
+		CPPUNIT_ASSERT(inter2.get_nl_threads()==4);
+		CPPUNIT_ASSERT(inter2.get_nl_reader()==1);
+
+		System sys1(inter1);
+		System sys2(inter2);
+		CPPUNIT_ASSERT(sys1.nb_ctr==sys2.nb_ctr);
+		CPPUNIT_ASSERT(sys1.box==sys2.box);
+		for (int i=0; i<sys1.nb_ctr; i++) {
+			CPPUNIT_ASSERT(sys1.ops[i]==sys2.ops[i]);
+			CPPUNIT_ASSERT(sameExpr(sys2.ctrs[i].f.expr(), sys1.ctrs[i].f.expr()));
+		}
+	}
+}
+
+
+void TestAmpl::lazy() {
+	const char* options[] = { "lazy=1", "lazy=1 nl_reader=1" };
+	for (int k=0; k<2; k++) {
+		set_options(options[k]);
+		AmplInterface inter(SRCDIR_TESTS "/ex_ampl/ex8.nl");
+		set_options(NULL);
+		CPPUNIT_ASSERT(inter.get_lazy()==1);
+		CPPUNIT_ASSERT(inter.get_nb_ampl_ctr()==11);
+		CPPUNIT_ASSERT(inter.find_ctr("con4")==3);
+		CPPUNIT_ASSERT(inter.find_ctr("con12")==-1);
+
+		CPPUNIT_ASSERT(inter.get_ctr_bounds(1)==Interval(0.37842));
+
+		// only con4 and con2 are translated
+		inter.load_ctr("con4");
+		inter.load_ctr(1);
+		inter.load_ctr(3); // already added
+
+		System sys(inter);
+		CPPUNIT_ASSERT(sys.nb_ctr==2);
+		CPPUNIT_ASSERT(sys.nb_var==13);
+		IntervalVector x(13, Interval(1));
+		check(sys.ctrs[0].f.eval(x), Interval(1-0.15585+1-0.19807), 1e-9);
+		check(sys.ctrs[1].f.eval(x), Interval(1-0.16275+1-0.37842), 1e-9);
+	}
+}
+
+
+void TestAmpl::streaming() {
+	TmpFile nl("streaming.nl");
+	write_nl(nl.c_str(), 20000, 20000, 1);
+
+	// each constraint is read, then added to the system
+	set_options("nl_reader=1 streaming=1");
+	{
+		AmplInterface inter(nl.path);
+		CPPUNIT_ASSERT(inter.get_nl_reader()==1);
+		CPPUNIT_ASSERT(inter.get_streaming()==1);
+		CPPUNIT_ASSERT(inter.get_max_pending_rows()==1);
+		System sys(inter);
+		CPPUNIT_ASSERT(sys.nb_ctr==20000);
+		check(sys.ctrs[19999].f.eval(IntervalVector(20000,Interval(0.5))), Interval(0.25-1), 1e-9);
+	}
+
+	// same with the presolve (see duplicate_rows)
+	set_options("nl_reader=1 streaming=1 presolve=1");
+	{
+		AmplInterface inter(nl.path);
+		CPPUNIT_ASSERT(inter.get_max_pending_rows()==1);
+	}
+
+	// all the constraints are read first
+	set_options("nl_reader=1");
+	{
+		AmplInterface inter(nl.path);
+		CPPUNIT_ASSERT(inter.get_max_pending_rows()==20000);
+	}
+
+	// the ASL is used if required (the model read by the ASL is kept)
+	set_options("nl_reader=0 streaming=1");
+	{
+		AmplInterface inter(nl.path);
+		CPPUNIT_ASSERT(inter.get_nl_reader()==0);
+		CPPUNIT_ASSERT(inter.get_ctr_bounds(0)==Interval(NEG_INFINITY,1));
+		System sys(inter);
+		CPPUNIT_ASSERT(sys.nb_ctr==20000);
+		check(sys.ctrs[0].f.eval(IntervalVector(20000,Interval(0.5))), Interval(0.25-1), 1e-9);
+	}
+	set_options(NULL);
+
+	// The memory at the peak: 2 million numbers, folded into 50 constants.
+	// The ASL keeps a node per number (more than 16 bytes each) whereas, in
+	// streaming mode, only the mapped file (3 bytes per number) and one
+	// constraint at a time are held.
+	TmpFile numbers("numbers.nl");
+	write_nl_numbers(numbers.c_str(), 50, 40000);
+	std::ifstream in(numbers.c_str(), std::ios::binary | std::ios::ate);
+	long file_kb=((long) in.tellg())/1024;
+	long bound=file_kb + 16*1024;
+	long rss=peak_rss(numbers.c_str(), "streaming=1");
+	if (rss>=0) {
+		CPPUNIT_ASSERT(rss<bound);
+		CPPUNIT_ASSERT(peak_rss(numbers.c_str(), "nl_reader=0")>bound);
+	}
+}
+
+
+void TestAmpl::aux_vars() {
+	AmplInterface inter1(SRCDIR_TESTS "/ex_ampl/ex6.nl");
+	set_options("aux_vars=1");
+	AmplInterface inter2(SRCDIR_TESTS "/ex_ampl/ex6.nl");
+	set_options(NULL);
+	CPPUNIT_ASSERT(inter2.get_aux_vars()==1);
+
+	System sys1(inter1);
+	System sys2(inter2);
+
+	// 6 defined variables (including the copies made by AMPL)
+	CPPUNIT_ASSERT(sys2.nb_var==2+6);
+	CPPUNIT_ASSERT(sys2.nb_ctr==3+6);
+	for (int i=3; i<sys2.nb_ctr; i++)
+		CPPUNIT_ASSERT(sys2.ops[i]==EQ);
+	CPPUNIT_ASSERT(sys2.goal->expr().size < sys1.goal->expr().size);
+
+	// values of the auxiliary variables at x=1, y=2 (each defined
+	// variable only depends on the previous ones)
+	Vector x(8, 0.0);
+	x[0] = 1;
+	x[1] = 2;
+	for (int k=0; k<6; k++) {
+		Vector f = sys2.f_ctrs.eval_vector(IntervalVector(x)).mid();
+		for (int j=0; j<6; j++)
+			x[2+j] -= f[3+j];
+	}
+	check_relatif(sys2.f_ctrs.eval_vector(IntervalVector(x)).subvector(0,2),
+			sys1.f_ctrs.eval_vector(IntervalVector(x.subvector(0,1))), 1e-9);
+	check_relatif(sys2.goal->eval(IntervalVector(x)), sys1.goal->eval(IntervalVector(x.subvector(0,1))), 1e-9);
+
+	// same lifted system with the native reader
+	set_options("aux_vars=1 nl_reader=1");
+	AmplInterface inter3(SRCDIR_TESTS "/ex_ampl/ex6.nl");
+	set_options(NULL);
+	System sys3(inter3);
+	CPPUNIT_ASSERT(sys3.nb_var==sys2.nb_var);
+	CPPUNIT_ASSERT(sys3.nb_ctr==sys2.nb_ctr);
+	check_relatif(sys3.f_ctrs.eval_vector(IntervalVector(x)), sys2.f_ctrs.eval_vector(IntervalVector(x)), 1e-9);
+}
+
+
+void TestAmpl::const_folding() {
+	const char* options[] = { "", "nl_reader=1" };
+	for (int k=0; k<2; k++) {
+		set_options(options[k]);
+		// (0.1+0.2)*x + log(10) <= 10
+		AmplInterface inter1(SRCDIR_TESTS "/ex_ampl/const_folding1.nl");
+		// same expression, with the constants computed by hand
+		AmplInterface inter2(SRCDIR_TESTS "/ex_ampl/const_folding2.nl");
+		set_options(NULL);
+		CPPUNIT_ASSERT(inter1.get_nb_folded()==2);
+		CPPUNIT_ASSERT(inter2.get_nb_folded()==0);
+
+		// no simplification by Ibex
+		inter1.set_simplification_level(0);
+		inter2.set_simplification_level(0);
+		System sys1(inter1);
+		System sys2(inter2);
+		CPPUNIT_ASSERT(sys1.ctrs[0].f.expr().size==sys2.ctrs[0].f.expr().size);
+
+		// the folded constants enclose the exact values
+		Interval y=sys1.ctrs[0].f.eval(IntervalVector(1,Interval(1)));
+		CPPUNIT_ASSERT(y.contains(0.3+::log(10.0)-10));
+		CPPUNIT_ASSERT(y.diam()<1e-12);
+	}
+}
+
+
+void TestAmpl::simpl_budget() {
+	const char* files[] = { "ex1", "ex5", "ex6", "ex8" };
+	for (int k=0; k<4; k++) {
+		string nlfile = string(SRCDIR_TESTS "/ex_ampl/") + files[k] + ".nl";
+		AmplInterface inter1(nlfile);
+		set_options("simpl_budget=10");
+		AmplInterface inter2(nlfile);
+		// the budget is spent by the first expression
+		set_options("simpl_budget=1e-12");
+		AmplInterface inter3(nlfile);
+		set_options(NULL);
+		CPPUNIT_ASSERT(inter2.get_simpl_budget()==10);
+
+		System sys1(inter1);
+		System sys2(inter2);
+		System sys3(inter3);
+		CPPUNIT_ASSERT(sys2.nb_ctr==sys1.nb_ctr);
+		CPPUNIT_ASSERT(sys3.nb_ctr==sys1.nb_ctr);
+
+		// one simplified expression per constraint of the model and for the goal
+		int nb2=0, nb3=0;
+		for (int level=0; level<=3; level++) {
+			nb2 += inter2.get_simpl_count(level);
+			nb3 += inter3.get_simpl_count(level);
+		}
+		CPPUNIT_ASSERT(nb2==nb3);
+		CPPUNIT_ASSERT(nb2>0);
+		CPPUNIT_ASSERT(inter2.get_simpl_count(0)==0);
+		CPPUNIT_ASSERT(inter3.get_simpl_count(0)>=nb3-1);
+
+		IntervalVector box(sys1.box);
+		box &= IntervalVector(sys1.nb_var, Interval(-10,10));
+		IntervalVector x(box.mid());
+		if (sys1.nb_ctr>0) {
+			check_relatif(sys2.f_ctrs.eval_vector(x), sys1.f_ctrs.eval_vector(x), 1e-6);
+			check_relatif(sys3.f_ctrs.eval_vector(x), sys1.f_ctrs.eval_vector(x), 1e-6);
+		}
+		if (sys1.goal) {
+			check_relatif(sys2.goal->eval(x), sys1.goal->eval(x), 1e-6);
+			check_relatif(sys3.goal->eval(x), sys1.goal->eval(x), 1e-6);
+		}
+	}
+}
+
+
+void TestAmpl::range_ctrs() {
+	// -0.5 <= x[i]*x[i+1] <= 0.5 (indices modulo 3): the exact bounds
+	AmplInterface inter(SRCDIR_TESTS "/ex_ampl/range_ctrs.nl");
+	System sys(inter);
+	CPPUNIT_ASSERT(sys.nb_ctr==6);
+	for (int i=0; i<sys.nb_ctr; i++)
+		CPPUNIT_ASSERT(sys.ops[i]==(i%2==0 ? LEQ : GEQ));
+
+	// x[0]*x[1] - 0.5 and x[0]*x[1] + 0.5 at x=1
+	IntervalVector x(3, Interval(1));
+	check(sys.ctrs[0].f.eval(x), Interval(0.5));
+	check(sys.ctrs[1].f.eval(x), Interval(1.5));
+
+	// min x0+x1 s.t. -0.5 <= x0*x1 <= 0.5: a loup is found
+	// (the minimum -1.5 is at (-1,-0.5) and (-0.5,-1))
+	AmplInterface inter2(SRCDIR_TESTS "/ex_ampl/range_optim.nl");
+	System sys2(inter2);
+	DefaultOptimizerConfig config(sys2);
+	config.set_timeout(10);
+	Optimizer o(config);
+	CPPUNIT_ASSERT(o.optimize(sys2.box)==Optimizer::SUCCESS);
+	CPPUNIT_ASSERT(o.get_loup()<POS_INFINITY);
+	CPPUNIT_ASSERT(o.get_loup()<=-1.5+1e-3);
+	CPPUNIT_ASSERT(o.get_loup()>=-1.5-1e-3);
+}
+
+
+void TestAmpl::fixed_vars() {
+	// x0*x1 + 3*x1 + x2 <= 1 with x0,x2 in [-1,1] and x1=2
+	const char* options[] = { "presolve=1", "presolve=1 nl_reader=1", "presolve=1 linear_form=1" };
+	for (int k=0; k<3; k++) {
+		set_options(options[k]);
+		AmplInterface inter(SRCDIR_TESTS "/ex_ampl/fixed_vars.nl");
+		set_options(NULL);
+		CPPUNIT_ASSERT(inter.get_presolve()==1);
+		CPPUNIT_ASSERT(inter.get_nb_fixed()==1);
+
+		System sys(inter);
+		CPPUNIT_ASSERT(sys.nb_var==2);
+		CPPUNIT_ASSERT(sys.nb_ctr==1);
+
+		// x0*2 + 3*2 + x2 - 1 at x0=1, x2=1
+		check(sys.ctrs[0].f.eval(IntervalVector(2,Interval(1))), Interval(8));
+	}
+
+	// without presolve
+	AmplInterface inter(SRCDIR_TESTS "/ex_ampl/fixed_vars.nl");
+	CPPUNIT_ASSERT(inter.get_nb_fixed()==0);
+	System sys(inter);
+	CPPUNIT_ASSERT(sys.nb_var==3);
+}
+
+
+void TestAmpl::bound_rows() {
+	// x+y=0, x<=0 and -y>=0: x<=0 and y<=0 are put in the
+	// bounds, then x+y=0 fixes x and y to 0 and is redundant.
+	const char* options[] = { "presolve=1", "presolve=1 nl_reader=1" };
+	for (int k=0; k<2; k++) {
+		set_options(options[k]);
+		AmplInterface inter(SRCDIR_TESTS "/ex_ampl/ex4.nl");
+		set_options(NULL);
+		CPPUNIT_ASSERT(inter.get_nb_bound_rows()==2);
+		CPPUNIT_ASSERT(inter.get_nb_redundant_rows()==1);
+		CPPUNIT_ASSERT(inter.get_nb_tightened()==2);
+		// all the variables would be fixed: they are kept
+		CPPUNIT_ASSERT(inter.get_nb_fixed()==0);
+
+		System sys(inter);
+		CPPUNIT_ASSERT(sys.nb_ctr==0);
+		CPPUNIT_ASSERT(sys.nb_var==2);
+		CPPUNIT_ASSERT(sys.box==IntervalVector(2,Interval(0)));
+	}
+
+	// 3*x2 = 1-x0*x1 is not on a single variable
+	set_options("presolve=1");
+	AmplInterface inter(SRCDIR_TESTS "/ex_ampl/fixed_vars.nl");
+	set_options(NULL);
+	CPPUNIT_ASSERT(inter.get_nb_bound_rows()==0);
+}
+
+
+void TestAmpl::presolve() {
+	// x0 + 2*x1 + x2 <= 1, x2 = 1 and x0 + 2*x1 >= -3 with x0,x1 in [-1,1]
+
+	set_options("presolve=1");
+	AmplInterface inter(SRCDIR_TESTS "/ex_ampl/presolve.nl");
+	set_options(NULL);
+	System sys(inter);
+
+	// 1st round: x2<=4 (C0), x2=1 (C1, put in the bounds), C2 is redundant
+	// 2nd round: x1<=0.5 (C0), then no more reduction
+	CPPUNIT_ASSERT(inter.get_nb_bound_rows()==1);
+	CPPUNIT_ASSERT(inter.get_nb_redundant_rows()==1);
+	CPPUNIT_ASSERT(inter.get_nb_tightened()==2);
+	CPPUNIT_ASSERT(inter.get_nb_fixed()==1);
+
+	CPPUNIT_ASSERT(sys.nb_var==2);
+	CPPUNIT_ASSERT(sys.nb_ctr==1);
+	CPPUNIT_ASSERT(inter.get_ampl_row(0)==0);
+	CPPUNIT_ASSERT(sys.box[0]==Interval(-1,1));
+	CPPUNIT_ASSERT(sys.box[1]==Interval(-1,0.5));
+
+	// x0 + 2*x1 + 1 - 1 at x=(1,1)
+	check(sys.ctrs[0].f.eval(IntervalVector(2,Interval(1))), Interval(3));
+}
+
+void TestAmpl::duplicate_rows() {
+	// x0*x1 <= 1, x0*x1 >= -1, x0 + 2*x1 <= 2, 2*x0 + 4*x1 <= 3 and
+	// -x0 - 2*x1 <= 1 with x0,x1 in [-1,1]
+
+	const char* options[] = { "presolve=1", "presolve=1 nl_reader=1" };
+
+	for (int k=0; k<2; k++) {
+		set_options(options[k]);
+		AmplInterface inter(SRCDIR_TESTS "/ex_ampl/duplicate_rows.nl");
+		set_options(NULL);
+		System sys(inter);
+
+		// C1 is merged with C0, C3 and C4 with C2
+		CPPUNIT_ASSERT(inter.get_nb_duplicate_rows()==3);
+		CPPUNIT_ASSERT(sys.nb_var==2);
+		CPPUNIT_ASSERT(sys.nb_ctr==4);
+		CPPUNIT_ASSERT(inter.get_ampl_row(0)==0);
+		CPPUNIT_ASSERT(inter.get_ampl_row(1)==0);
+		CPPUNIT_ASSERT(inter.get_ampl_row(2)==2);
+		CPPUNIT_ASSERT(inter.get_ampl_row(3)==2);
+
+		// x0*x1 in [-1,1] and x0 + 2*x1 in [-1,1.5] at x=(0,0)
+		IntervalVector x(2,Interval::zero());
+		check(sys.ctrs[0].f.eval(x), Interval(-1));
+		check(sys.ctrs[1].f.eval(x), Interval(1));
+		check(sys.ctrs[2].f.eval(x), Interval(-1.5));
+		check(sys.ctrs[3].f.eval(x), Interval(1));
+	}
+
+	// without presolve
+	AmplInterface inter(SRCDIR_TESTS "/ex_ampl/duplicate_rows.nl");
+	System sys(inter);
+	CPPUNIT_ASSERT(inter.get_nb_duplicate_rows()==0);
+	CPPUNIT_ASSERT(sys.nb_ctr==5);
+
+	// not in streaming mode (the constraints are read one by one)
+	set_options("presolve=1 nl_reader=1 streaming=1");
+	AmplInterface inter2(SRCDIR_TESTS "/ex_ampl/duplicate_rows.nl");
+	set_options(NULL);
+	System sys2(inter2);
+	CPPUNIT_ASSERT(inter2.get_nb_duplicate_rows()==0);
+	CPPUNIT_ASSERT(sys2.nb_ctr==5);
+}
+
+void TestAmpl::components() {
+	// x11..x13 (con11) share nothing with x1..x10
+	set_options("decompose=1");
+	AmplInterface inter(SRCDIR_TESTS "/ex_ampl/ex8.nl");
+	set_options(NULL);
+	System sys(inter);
+
+	CPPUNIT_ASSERT(inter.get_nb_components()==2);
+	for (int i=0; i<13; i++)
+		CPPUNIT_ASSERT(inter.get_component(i)==(i<10 ? 0 : 1));
+
+	System* sys0 = inter.get_component_system(sys, 0);
+	System* sys1 = inter.get_component_system(sys, 1);
+	CPPUNIT_ASSERT(sys0 && sys1);
+	CPPUNIT_ASSERT(sys0->nb_var==10 && sys0->nb_ctr==10);
+	CPPUNIT_ASSERT(sys1->nb_var==3 && sys1->nb_ctr==1);
+	CPPUNIT_ASSERT(sys1->box==IntervalVector(3,Interval::all_reals()));
+	CPPUNIT_ASSERT(sameExpr(sys1->f_ctrs[0].expr(),"((x11+x12)+x13)"));
+	delete sys0;
+	delete sys1;
+
+	// without decomposition
+	AmplInterface inter2(SRCDIR_TESTS "/ex_ampl/ex8.nl");
+	CPPUNIT_ASSERT(inter2.get_nb_components()==1);
+
+	// min x0^2 + x1^2 + x2 s.t. x0 + x2 <= 1 with x0,x1,x2 in [-1,1]
+
+	const char* options[] = { "decompose=1", "decompose=1 nl_reader=1", "decompose=1 linear_form=1" };
+
+	for (int k=0; k<3; k++) {
+		set_options(options[k]);
+		AmplInterface inter3(SRCDIR_TESTS "/ex_ampl/components.nl");
+		set_options(NULL);
+		System sys3(inter3);
+
+		CPPUNIT_ASSERT(inter3.get_nb_components()==2);
+		CPPUNIT_ASSERT(inter3.get_component(0)==0);
+		CPPUNIT_ASSERT(inter3.get_component(1)==1);
+		CPPUNIT_ASSERT(inter3.get_component(2)==0);
+
+		System* s0 = inter3.get_component_system(sys3, 0);
+		System* s1 = inter3.get_component_system(sys3, 1);
+		CPPUNIT_ASSERT(s0 && s1);
+		CPPUNIT_ASSERT(s0->nb_var==2 && s0->nb_ctr==1);
+		CPPUNIT_ASSERT(s1->nb_var==1 && s1->nb_ctr==0);
+
+		// x0^2 + x2 at (0.5,1) and x1^2 at 2
+		IntervalVector x(2);
+		x[0] = 0.5;
+		x[1] = 1;
+		check(s0->goal->eval(x), Interval(1.25));
+		check(s1->goal->eval(IntervalVector(1,Interval(2))), Interval(4));
+		delete s0;
+		delete s1;
+	}
+
+	// the configuration of each subproblem: the initial point (0.5,0.5,-1)
+	// restricted to its variables gives an upper bound of its objective
+	set_options("decompose=1 warm_start=1");
+	AmplInterface inter4(SRCDIR_TESTS "/ex_ampl/components.nl");
+	set_options(NULL);
+	System sys4(inter4);
+	CPPUNIT_ASSERT(inter4.get_component_vars(0).size()==2);
+	CPPUNIT_ASSERT(inter4.get_component_vars(0)[1]==2);
+	CPPUNIT_ASSERT(inter4.get_component_vars(1)==vector<int>(1,1));
+	CPPUNIT_ASSERT(inter4.get_component_ctrs(sys4, 0)==vector<int>(1,0));
+	CPPUNIT_ASSERT(inter4.get_component_ctrs(sys4, 1).empty());
+
+	double f0[] = { 0.25-1, 0.25 };
+	for (int k=0; k<2; k++) {
+		System* s = inter4.get_component_system(sys4, k);
+		AmplOptimizerConfig config(*s, inter4, sys4, k);
+		Vector x(s->nb_var);
+		double loup;
+		CPPUNIT_ASSERT(config.warm_start(x, loup));
+		CPPUNIT_ASSERT(loup<=f0[k]+1e-8);
+		CPPUNIT_ASSERT(s->box.contains(x));
+		CPPUNIT_ASSERT(s->goal->eval(IntervalVector(x)).lb()<=loup);
+		delete s;
+	}
+
+	// ibexopt: the minimum -1 is at (0,0,-1), whether the subproblems are
+	// solved separately (-AMPL), or the system as a whole (COV output)
+	{
+		TmpFile nl("components.nl");
+		set_options("decompose=1");
+		CPPUNIT_ASSERT(run_ibexopt(nl, "components.nl", "-AMPL")==0);
+		CPPUNIT_ASSERT(run_ibexopt(nl, "components.nl", ("-o " + nl.dir + "/components.cov").c_str())==0);
+		set_options(NULL);
+		std::vector<double> x=read_sol_point(nl.c_str(), (nl.dir + "/components.sol").c_str());
+		CPPUNIT_ASSERT(x.size()==3);
+		Vector p(3, &x[0]);
+		CPPUNIT_ASSERT(satisfies(sys4, p, 1e-6));
+		CPPUNIT_ASSERT(sys4.goal->eval(IntervalVector(p)).lb()<=-1+1e-6);
+		CovOptimData data((nl.dir + "/components.cov").c_str());
+		CPPUNIT_ASSERT(data.optimizer_status()==Optimizer::SUCCESS);
+		CPPUNIT_ASSERT(data.loup()<=-1+1e-6);
+	}
+}
+
+void TestAmpl::blocks() {
+	// x0^2 = 4, x0*x1 = 2 and x1*x2 + x2 = 1 with x0 in [1,10], x1,x2 in [-10,10]
+
+	const char* options[] = { "blocks=1", "blocks=1 nl_reader=1" };
+
+	for (int k=0; k<2; k++) {
+		set_options(options[k]);
+		AmplInterface inter(SRCDIR_TESTS "/ex_ampl/blocks.nl");
+		set_options(NULL);
+		System sys(inter);
+
+		// one block per equation, in the order of resolution
+		CPPUNIT_ASSERT(inter.get_nb_blocks()==3);
+		for (int b=0; b<3; b++) {
+			CPPUNIT_ASSERT(inter.get_block_ctrs(b)==vector<int>(1,b));
+			CPPUNIT_ASSERT(inter.get_block_vars(b)==vector<int>(1,b));
+		}
+
+		// one Newton step per block: x0 in [1,4.1875], x1 in 2/x0, x2 in 1/(x1+1)
+		CtcBlocks ctc(sys, inter);
+		IntervalVector box = sys.box;
+		ctc.contract(box);
+		CPPUNIT_ASSERT(box[0].is_subset(Interval(1,4.2)) && box[0].contains(2));
+		CPPUNIT_ASSERT(box[1].is_subset(Interval(0.47,2.01)) && box[1].contains(1));
+		CPPUNIT_ASSERT(box[2].is_subset(Interval(0.33,0.68)) && box[2].contains(0.5));
+	}
+
+	// ex8: the 10 coupled equations and con11
+	set_options("blocks=1");
+	AmplInterface inter8(SRCDIR_TESTS "/ex_ampl/ex8.nl");
+	set_options(NULL);
+	size_t nb = 0;
+	bool con11 = false;
+	for (int b=0; b<inter8.get_nb_blocks(); b++) {
+		nb += inter8.get_block_ctrs(b).size();
+		if (inter8.get_block_ctrs(b)==vector<int>(1,10)) con11 = true;
+	}
+	CPPUNIT_ASSERT(nb==11);
+	CPPUNIT_ASSERT(con11);
+
+	// the blocks of each subproblem of ex8 (con11 is alone in the second one)
+	set_options("blocks=1 decompose=1");
+	AmplInterface inter9(SRCDIR_TESTS "/ex_ampl/ex8.nl");
+	set_options(NULL);
+	System sys9(inter9);
+	CPPUNIT_ASSERT(inter9.get_nb_components()==2);
+	int nb_blocks = 0;
+	for (int k=0; k<2; k++) {
+		System* s = inter9.get_component_system(sys9, k);
+		CtcBlocks ctc(*s, inter9, 0, -1, inter9.get_component_vars(k), inter9.get_component_ctrs(sys9, k));
+		if (k==1) CPPUNIT_ASSERT(ctc.nb_blocks()==1);
+		nb_blocks += ctc.nb_blocks();
+		delete s;
+	}
+	CPPUNIT_ASSERT(nb_blocks==inter9.get_nb_blocks());
+
+	// without blocks
+	AmplInterface inter(SRCDIR_TESTS "/ex_ampl/blocks.nl");
+	CPPUNIT_ASSERT(inter.get_nb_blocks()==0);
+}
+
+void TestAmpl::first_sol() {
+	// a model without objective
+	set_options("first_sol=1");
+	AmplInterface inter(SRCDIR_TESTS "/ex_ampl/ex3.nl");
+	set_options(NULL);
+	System sys(inter);
+	CPPUNIT_ASSERT(sys.goal==NULL);
+	CPPUNIT_ASSERT(inter.get_first_sol()==1);
+
+	AmplInterface inter2(SRCDIR_TESTS "/ex_ampl/ex3.nl");
+	CPPUNIT_ASSERT(inter2.get_first_sol()==0);
+
+	// the point written by ibexopt, with and without first_sol
+	for (int first=1; first>=0; first--) {
+		TmpFile nl("ex3.nl");
+		set_options(first ? "first_sol=1" : NULL);
+		CPPUNIT_ASSERT(run_ibexopt(nl, "ex3.nl", "-AMPL")==0);
+		set_options(NULL);
+		std::vector<double> x=read_sol_point(nl.c_str(), (nl.dir + "/ex3.sol").c_str());
+		CPPUNIT_ASSERT(x.size()==2);
+		CPPUNIT_ASSERT(satisfies(sys, Vector(2, &x[0]), 1e-6));
+	}
+}
+
+void TestAmpl::warm_start() {
+	const char* options[] = { "warm_start=1", "warm_start=1 nl_reader=1" };
+
+	for (int k=0; k<2; k++) {
+		// a feasible initial point: f(x0)=0.25
+		set_options(options[k]);
+		AmplInterface inter(SRCDIR_TESTS "/ex_ampl/warm_start.nl");
+		set_options(NULL);
+		System sys(inter);
+
+		Vector x0(2);
+		CPPUNIT_ASSERT(inter.get_x0(x0));
+		CPPUNIT_ASSERT(x0[0]==0.5 && x0[1]==-0.25);
+
+		AmplOptimizerConfig config(sys, inter);
+		Vector x(2);
+		double loup;
+		CPPUNIT_ASSERT(config.warm_start(x, loup));
+		CPPUNIT_ASSERT(loup<=0.25);
+		CPPUNIT_ASSERT(sys.box.contains(x));
+		CPPUNIT_ASSERT(x[0]*x[1]<=0.5+1e-8);
+		CPPUNIT_ASSERT(x[0]+x[1]<=loup+1e-8);
+
+		// the warm start uses the loup finder of the optimizer, which is
+		// not changed by it: the search finds the same minimum as without
+		{
+			Optimizer o(config);
+			CPPUNIT_ASSERT(&o.loup_finder==&config.get_loup_finder());
+			CPPUNIT_ASSERT(o.optimize(sys.box)==Optimizer::SUCCESS);
+			AmplOptimizerConfig config0(sys, inter);
+			Optimizer o0(config0);
+			CPPUNIT_ASSERT(o0.optimize(sys.box)==Optimizer::SUCCESS);
+			CPPUNIT_ASSERT(fabs(o.get_loup()-o0.get_loup())<=1e-2);
+			CPPUNIT_ASSERT(fabs(o.get_uplo()-o0.get_uplo())<=1e-2);
+		}
+
+		// an infeasible initial point (x0*x1=1), far from the feasible ones
+		set_options(options[k]);
+		AmplInterface inter2(SRCDIR_TESTS "/ex_ampl/warm_start_far.nl");
+		set_options(NULL);
+		System sys2(inter2);
+		AmplOptimizerConfig config2(sys2, inter2);
+		CPPUNIT_ASSERT(!config2.warm_start(x, loup));
+	}
+
+	// disabled by default
+	AmplInterface inter(SRCDIR_TESTS "/ex_ampl/warm_start.nl");
+	CPPUNIT_ASSERT(inter.get_warm_start()==0);
+	System sys(inter);
+	AmplOptimizerConfig config(sys, inter);
+	Vector x(2);
+	double loup;
+	CPPUNIT_ASSERT(!config.warm_start(x, loup));
+
+	// ibexopt: the minimum is -1.5 (at (-1,-0.5) or (-0.5,-1)), whether
+	// the search finds a better point than the warm start or not
+	{
+		TmpFile nl("warm_start.nl");
+		set_options("warm_start=1");
+		CPPUNIT_ASSERT(run_ibexopt(nl, "warm_start.nl", "-AMPL")==0);
+		set_options(NULL);
+		std::vector<double> x=read_sol_point(nl.c_str(), (nl.dir + "/warm_start.sol").c_str());
+		CPPUNIT_ASSERT(x.size()==2);
+		Vector p(2, &x[0]);
+		CPPUNIT_ASSERT(satisfies(sys, p, 1e-6));
+		CPPUNIT_ASSERT(sys.goal->eval(IntervalVector(p)).lb()<=-1.49); // (rel_eps_f)
+	}
+
+	// without -AMPL, the warm start is ignored: the COV file holds the result
+	// of the optimizer
+	{
+		TmpFile nl("warm_start.nl");
+		set_options("warm_start=1");
+		CPPUNIT_ASSERT(run_ibexopt(nl, "warm_start.nl", ("-o " + nl.dir + "/warm_start.cov").c_str())==0);
+		set_options(NULL);
+		CovOptimData data((nl.dir + "/warm_start.cov").c_str());
+		CPPUNIT_ASSERT(data.optimizer_status()==Optimizer::SUCCESS);
+		CPPUNIT_ASSERT(data.loup()<=-1.49);
+	}
+}
+
+void TestAmpl::start_priority() {
+	// the start point is the initial point...
+	set_options("start_priority=2");
+	AmplInterface inter(SRCDIR_TESTS "/ex_ampl/warm_start.nl");
+	set_options(NULL);
+	CPPUNIT_ASSERT(inter.get_start_priority()==2);
+	Vector x(2);
+	CPPUNIT_ASSERT(inter.get_start_point(x));
+	CPPUNIT_ASSERT(x[0]==0.5 && x[1]==-0.25);
+
+	// ... or the suffix ibex_start
+	AmplInterface inter2(SRCDIR_TESTS "/ex_ampl/start_suffix.nl");
+	CPPUNIT_ASSERT(inter2.get_start_priority()==0);
+	CPPUNIT_ASSERT(inter2.get_start_point(x));
+	CPPUNIT_ASSERT(x[0]==-0.5 && x[1]==0.75);
+	CPPUNIT_ASSERT(inter2.get_x0(x));
+	CPPUNIT_ASSERT(x[0]==0.5 && x[1]==-0.25);
+
+	// the cells containing (0.5,-0.25) are popped first during 2 nodes
+	Vector x0(2);
+	x0[0]=0.5;
+	x0[1]=-0.25;
+	CellStack stack;
+	CellBufferStart buffer(stack, x0, 2, 2);
+
+	Cell* a=start_cell(Interval(0,1), Interval(-1,0), 3);
+	Cell* b=start_cell(Interval(-1,0), Interval(-1,0), 1);
+	buffer.push(a);
+	buffer.push(b);
+	CPPUNIT_ASSERT(buffer.size()==2);
+	CPPUNIT_ASSERT(buffer.minimum()==0);
+	CPPUNIT_ASSERT(buffer.top()==a);
+	CPPUNIT_ASSERT(buffer.pop()==a);
+	delete a;
+
+	Cell* c=start_cell(Interval(-1,0), Interval(-1,1), 2);
+	Cell* d=start_cell(Interval(0.5,1), Interval(-0.5,0), 2);
+	buffer.push(c);
+	buffer.push(d);
+	CPPUNIT_ASSERT(stack.size()==2);
+	CPPUNIT_ASSERT(buffer.pop()==d);
+	delete d;
+	CPPUNIT_ASSERT(buffer.nb_popped()==2);
+
+	// end of the early phase: the default order
+	Cell* e=start_cell(Interval(0,1), Interval(-1,0), 1);
+	buffer.push(e);
+	CPPUNIT_ASSERT(stack.size()==3);
+	CPPUNIT_ASSERT(buffer.pop()==e);
+	delete e;
+	CPPUNIT_ASSERT(buffer.pop()==c);
+	delete c;
+	CPPUNIT_ASSERT(buffer.size()==1);
+}
+
 
 } // end namespace
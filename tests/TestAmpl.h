@@ -40,6 +40,27 @@ public:
 		CPPUNIT_TEST(bearing);
 		CPPUNIT_TEST(option1);
 		CPPUNIT_TEST(option2);
+		CPPUNIT_TEST(large_sum);
+		CPPUNIT_TEST(baseline_trees);
+		CPPUNIT_TEST(linear_form);
+		CPPUNIT_TEST(sharing);
+		CPPUNIT_TEST(nl_reader);
+		CPPUNIT_TEST(nl_threads);
+		CPPUNIT_TEST(lazy);
+		CPPUNIT_TEST(streaming);
+		CPPUNIT_TEST(aux_vars);
+		CPPUNIT_TEST(const_folding);
+		CPPUNIT_TEST(simpl_budget);
+		CPPUNIT_TEST(range_ctrs);
+		CPPUNIT_TEST(fixed_vars);
+		CPPUNIT_TEST(bound_rows);
+		CPPUNIT_TEST(presolve);
+		CPPUNIT_TEST(duplicate_rows);
+		CPPUNIT_TEST(components);
+		CPPUNIT_TEST(blocks);
+		CPPUNIT_TEST(first_sol);
+		CPPUNIT_TEST(warm_start);
+		CPPUNIT_TEST(start_priority);
 
 	CPPUNIT_TEST_SUITE_END();
 
@@ -55,6 +76,27 @@ public:
 	void bearing();
 	void option1();
 	void option2();
+	void large_sum();
+	void baseline_trees();
+	void linear_form();
+	void sharing();
+	void nl_reader();
+	void nl_threads();
+	void lazy();
+	void streaming();
+	void aux_vars();
+	void const_folding();
+	void simpl_budget();
+	void range_ctrs();
+	void fixed_vars();
+	void bound_rows();
+	void presolve();
+	void duplicate_rows();
+	void components();
+	void blocks();
+	void first_sol();
+	void warm_start();
+	void start_priority();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestAmpl);
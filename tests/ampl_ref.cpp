@@ -0,0 +1,278 @@
+/* ============================================================================
+ * I B E X - ampl_ref.cpp
+ * ============================================================================
+ * Copyright   : IMT Atlantique (FRANCE)
+ * License     : This program can be distributed under the terms of the GNU LGPL.
+ *               See the file COPYING.LESSER.
+ *
+ * Author(s)   : Jordan Ninin
+ * Created     : Oct 17, 2026
+ * ---------------------------------------------------------------------------- */
+
+#include "ampl_ref.h"
+#include "ibex.h"
+
+// (after ibex.h: opcode.hd defines EQ, LT, etc.)
+#include "asl.h"
+#include "nlp.h"
+#include "opcode.hd"
+#include "r_opn.hd" /* for N_OPS */
+
+#include <stdint.h>
+#include <cstring>
+#include <map>
+#include <sstream>
+
+#ifndef Intcast
+#define Intcast (size_t)
+#endif
+
+#define VAR_E     ((const ASL_fg *) asl) -> I.var_e_
+#define CON_DE    ((const ASL_fg *) asl) -> I.con_de_
+#define CEXPS1 ((const ASL_fg *) asl) -> I.cexps1_
+#define CEXPS ((const ASL_fg *) asl) -> I.cexps_
+
+using namespace ibex;
+
+namespace {
+
+// The original (recursive) translator of AmplInterface, unchanged except
+// for the context, passed explicitly.
+struct RefTranslator {
+	ASL* asl;
+	const ExprSymbol** _x;
+	std::map<size_t,int> opmap;
+	std::map<int,const ExprNode*> var_data;
+
+	const ExprNode& add_linpart(const ExprNode* body, int nlin, linpart* L) {
+		for(int i = 0; i < nlin; i++ ) {
+			double coeff = (L[i]).fac;
+			int index = ((uintptr_t) (L[i].v.rp) - (uintptr_t) VAR_E) / sizeof (expr_v);
+			if ((dynamic_cast<const ExprConstant*>(body))&&(((ExprConstant*)(body))->is_zero())) {
+				if (coeff==1) {
+					body = &((*(_x[index])));
+				} else if (coeff==-1) {
+					body = &( - (*(_x[index])));
+				} else if (coeff != 0) {
+					body = &(coeff * (*(_x[index])));
+				}
+			} else {
+				if (coeff==1) {
+					body = &(*body + (*(_x[index])));
+				} else if (coeff==-1) {
+					body = &(*body - (*(_x[index])));
+				} else if (coeff != 0) {
+					body = &(*body +coeff * (*(_x[index])));
+				}
+			}
+		}
+		return *body;
+	}
+
+	const ExprNode& nl2expr(expr *e) {
+
+		switch (opmap[Intcast (e -> op)]) {
+
+		case OPNUM:    return  (ExprConstant::new_scalar(((expr_n *)e)->v));
+		case OPPLUS:   {
+			if (opmap[Intcast (e->R.e->op)]==OPUMINUS) {
+				return  (( nl2expr(e -> L.e)) - nl2expr((e->R.e)->L.e) );
+			} else {
+				if (opmap[Intcast (e->L.e->op)]==OPUMINUS) {
+					return  (nl2expr(e->R.e) - nl2expr((e->L.e)->L.e) );
+				} else {
+					return  (nl2expr(e->R.e) + nl2expr(e->L.e) );
+				}
+			}
+		}
+		case OPMINUS:  {
+			if (opmap[Intcast (e->R.e->op)]==OPUMINUS)  {
+				return (( nl2expr(e->L.e)) + nl2expr((e->R.e)->L.e) );
+			} else {
+				return  (( nl2expr(e->L.e)) - nl2expr(e->R.e));
+			}
+		}
+		case OPDIV:    return  (( nl2expr(e -> L.e)) / (nl2expr(e -> R.e)));
+		case OPMULT:   return  (operator*((nl2expr (e -> L.e)) , (nl2expr(e -> R.e))));
+		case OPPOW:    return  pow( nl2expr(e -> L.e), nl2expr(e -> R.e));
+		case OP1POW:   {
+			if (((int) (((expr_n *)e->R.e)->v) )==(((expr_n *)e->R.e)->v)) {
+				return pow( nl2expr(e -> L.e), (int) (((expr_n *)e->R.e)->v));
+			} else
+				return pow( nl2expr(e -> L.e), ExprConstant::new_scalar(((expr_n *)e->R.e)->v));
+		}
+		case OP2POW:   return sqr( nl2expr(e -> L.e));
+		case OPCPOW:   return pow(ExprConstant::new_scalar(((expr_n *)e->L.e)->v), nl2expr(e -> R.e));
+		case MINLIST: {
+			expr **ep = e->L.ep;
+			const ExprNode* ee = &(nl2expr(*ep));
+			ep++;
+			while (ep < e->R.ep) {
+				ee = &(min(*ee , nl2expr(*ep)));
+				ep++;
+			}
+			return *ee;
+		}
+		case MAXLIST:  {
+			expr **ep = e->L.ep;
+			const ExprNode* ee = &(nl2expr(*ep));
+			ep++;
+			while (ep < e->R.ep) {
+				ee = &(max(*ee , nl2expr(*ep)));
+				ep++;
+			}
+			return *ee;
+		}
+		case OPSUMLIST: {
+			expr **ep = e->L.ep;
+			const ExprNode* ee = &(nl2expr(*ep));
+			ep++;
+			while (ep < e->R.ep) {
+				if (opmap[Intcast ((*ep)->op)]==OPUMINUS) {
+					ee = &(*ee - nl2expr((*ep)->L.e) );
+				} else {
+					ee = &(*ee + nl2expr(*ep) );
+				}
+				ep++;
+			}
+			return *ee;
+		}
+		case ABS:      return abs( nl2expr(e -> L.e));
+		case OPUMINUS: {
+			if (opmap[Intcast (e->L.e->op)]==OPUMINUS)  {
+				return  (nl2expr((e -> L.e)->L.e));
+			} else {
+				return  (operator-(nl2expr(e -> L.e)));
+			}
+		}
+		case OP_sqrt:  return sqrt(nl2expr(e -> L.e));
+		case OP_exp:   return exp( nl2expr(e -> L.e));
+		case OP_log:   return log( nl2expr(e -> L.e));
+		case OP_log10: return ((ExprConstant::new_scalar(1.0/log(Interval(10.0)))) * log(nl2expr (e -> L.e)));
+		case OP_cos:   return cos( nl2expr(e -> L.e));
+		case OP_sin:   return sin( nl2expr(e -> L.e));
+		case OP_tan:   return tan( nl2expr(e -> L.e));
+		case OP_cosh:  return cosh(nl2expr(e -> L.e));
+		case OP_sinh:  return sinh(nl2expr(e -> L.e));
+		case OP_tanh:  return tanh(nl2expr(e -> L.e));
+		case OP_acos:  return acos(nl2expr(e -> L.e));
+		case OP_asin:  return asin(nl2expr(e -> L.e));
+		case OP_atan:  return atan(nl2expr(e -> L.e));
+		case OP_asinh: return asinh(nl2expr(e -> L.e));
+		case OP_acosh: return acosh(nl2expr(e -> L.e));
+		case OP_atanh: return atanh(nl2expr(e -> L.e));
+		case OP_atan2: return atan2(nl2expr(e -> L.e), nl2expr(e -> R.e));
+		case FLOOR:   return floor(nl2expr(e -> L.e));
+		case CEIL:    return ceil(nl2expr(e -> L.e));
+		case OPVARVAL:  {
+			int j = ((expr_v *) e) -> a;
+			if (j<n_var) {
+				return (*(_x[j]));
+			}
+			// common expression | defined variable
+			int k = (expr_v *)e - VAR_E;
+			if (var_data.find(k)!=var_data.end())
+				return *var_data[k];
+			j = k - n_var;
+			const ExprNode* body;
+			if( j < ncom0 ) {
+				cexp *common = CEXPS +j;
+				body = &add_linpart(&nl2expr(common->e), common->nlin, common->L);
+			} else {
+				cexp1 *common = (CEXPS1 - ncom0) +j ;
+				body = &add_linpart(&nl2expr(common->e), common->nlin, common->L);
+			}
+			var_data[k] = body;
+			return *body;
+		}
+		default:
+			ibex_error("ref_ctr_bodies: unknown operator");
+			throw -2;
+		}
+	}
+};
+
+}
+
+std::vector<std::string> ref_ctr_bodies(const char* nlfile) {
+	RefTranslator t;
+	ASL* asl = t.asl = (ASL*) ASL_alloc (ASL_read_fg);
+
+	for (size_t i=0; i<N_OPS; i++)
+		t.opmap[ Intcast (r_ops[i]) ] = i;
+
+	char* stub = strdup(nlfile);
+	FILE* nl = jac0dim (stub, - (fint) strlen (stub));
+	fg_read (nl, ASL_return_read_err | ASL_findgroups | ASL_want_A_vals);
+
+	t._x = new const ExprSymbol*[n_var];
+	for (int i =0; i< n_var; i++)
+		t._x[i] = &(ExprSymbol::new_(var_name(i) , Dim::scalar()));
+
+	std::vector<const ExprNode*> body_con(n_con);
+	for (int i = 0; i<n_con;i++)
+		body_con[i] = &(t.nl2expr (CON_DE [i] . e));
+
+	for (int j = 0; j < n_var; j++){
+		for (int i = A_colstarts [j], k = A_colstarts [j+1] - i; k--; i++) {
+			if (A_vals[i]==0) continue; // (see ampl_ref.h)
+			const ExprNode*& b = body_con[A_rownos[i]];
+			if ((dynamic_cast<const ExprConstant*>(b))&&(((ExprConstant*)(b))->is_zero())) {
+				delete b;
+				if (A_vals[i]==1) {
+					b = t._x[j];
+				} else if (A_vals[i]==-1) {
+					b = &(- (*(t._x[j])));
+				} else {
+					b = &((A_vals[i]) * (*(t._x[j])));
+				}
+			} else {
+				if (A_vals[i]==1) {
+					b = &(*b + (*(t._x[j])));
+				} else if (A_vals[i]==-1) {
+					b = &(*b - (*(t._x[j])));
+				} else {
+					b = &(*b + (A_vals[i]) * (*(t._x[j])));
+				}
+			}
+		}
+	}
+
+	std::vector<std::string> res;
+	for (int i = 0; i<n_con;i++) {
+		std::stringstream s;
+		s.precision(7);
+		s << *body_con[i];
+		res.push_back(s.str());
+	}
+
+	Array<const ExprNode> nodes(n_con);
+	for (int i = 0; i<n_con;i++)
+		nodes.set_ref(i, *body_con[i]);
+	cleanup(nodes, false);
+	for (int i =0; i< n_var; i++)
+		delete t._x[i];
+	delete[] t._x;
+	ASL_free(&asl);
+	return res;
+}
+
+std::vector<double> read_sol_point(const char* nlfile, const char* solfile) {
+	ASL* asl = (ASL*) ASL_alloc (ASL_read_fg);
+
+	char* stub = strdup(nlfile);
+	FILE* nl = jac0dim (stub, - (fint) strlen (stub));
+	fclose(nl);
+
+	real *x=NULL, *y=NULL;
+	std::vector<double> res;
+	char* msg = fread_soln (solfile, &x, &y);
+	if (msg && x)
+		res.assign(x, x+n_var);
+	free(msg);
+	free(x);
+	free(y);
+	free(stub);
+	ASL_free(&asl);
+	return res;
+}
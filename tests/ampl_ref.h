@@ -0,0 +1,37 @@
+/* ============================================================================
+ * I B E X - ampl_ref.h
+ * ============================================================================
+ * Copyright   : IMT Atlantique (FRANCE)
+ * License     : This program can be distributed under the terms of the GNU LGPL.
+ *               See the file COPYING.LESSER.
+ *
+ * Author(s)   : Jordan Ninin
+ * Created     : Oct 17, 2026
+ * ---------------------------------------------------------------------------- */
+
+#ifndef __AMPL_REF_H__
+#define __AMPL_REF_H__
+
+#include <string>
+#include <vector>
+
+/**
+ * Reference translation of a .nl file: the body (nonlinear part plus linear
+ * part) of each constraint, as built by the original recursive translator of
+ * AmplInterface, printed with the precision of sameExpr().
+ *
+ * The linear parts are left-deep sums, as in the original translator
+ * (AmplInterface builds balanced sums, which coincide up to 3 terms).
+ * The zero coefficients of the Jacobian (variables that only appear in
+ * the nonlinear part) are skipped, as AmplInterface does.
+ */
+std::vector<std::string> ref_ctr_bodies(const char* nlfile);
+
+/**
+ * Primal values of the .sol file written for a .nl file (one per variable
+ * of the .nl file, in its order), read by the ASL. Empty if the .sol file
+ * contains no point (e.g., infeasible problem) or cannot be read.
+ */
+std::vector<double> read_sol_point(const char* nlfile, const char* solfile);
+
+#endif // __AMPL_REF_H__
@@ -0,0 +1,41 @@
+g3 1 1 0	# problem blocks
+ 3 3 0 0 3	# vars, constraints, objectives, ranges, eqns
+ 3 0	# nonlinear constraints, objectives
+ 0 0	# network constraints: nonlinear, linear
+ 3 0 0	# nonlinear vars in constraints, objectives, both
+ 0 0 0 1	# linear network variables; functions; arith, flags
+ 0 0 0 0 0	# discrete variables: binary, integer, nonlinear (b,c,o)
+ 5 0	# nonzeros in Jacobian, gradients
+ 0 0	# max name lengths: constraints, variables
+ 0 0 0 0 0	# common exprs: b,c,o,c1,o1
+C0
+o5
+v0
+n2
+C1
+o2
+v0
+v1
+C2
+o2
+v1
+v2
+r
+4 4
+4 2
+4 1
+b
+0 1 10
+0 -10 10
+0 -10 10
+k2
+2
+4
+J0 1
+0 0
+J1 2
+0 0
+1 0
+J2 2
+1 0
+2 1
@@ -0,0 +1,26 @@
+g3 1 1 0	# problem const_folding1
+ 1 1 0 0 0	# vars, constraints, objectives, ranges, eqns
+ 1 0	# nonlinear constraints, objectives
+ 0 0	# network constraints: nonlinear, linear
+ 1 0 0	# nonlinear vars in constraints, objectives, both
+ 0 0 0 1	# linear network variables; functions; arith, flags
+ 0 0 0 0 0	# discrete variables: binary, integer, nonlinear (b,c,o)
+ 1 0	# nonzeros in Jacobian, gradients
+ 0 0	# max name lengths: constraints, variables
+ 0 0 0 0 0	# common exprs: b,c,o,c1,o1
+C0
+o0
+o2
+o0
+n0.1
+n0.2
+v0
+o43
+n10
+r
+1 10
+b
+0 -1 1
+k0
+J0 1
+0 0
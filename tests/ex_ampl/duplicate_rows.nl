@@ -0,0 +1,50 @@
+g3 1 1 0	# problem duplicate_rows
+ 2 5 0 0 0	# vars, constraints, objectives, ranges, eqns
+ 2 0	# nonlinear constraints, objectives
+ 0 0	# network constraints: nonlinear, linear
+ 2 0 0	# nonlinear vars in constraints, objectives, both
+ 0 0 0 1	# linear network variables; functions; arith, flags
+ 0 0 0 0 0	# discrete variables: binary, integer, nonlinear (b,c,o)
+ 10 0	# nonzeros in Jacobian, gradients
+ 0 0	# max name lengths: constraints, variables
+ 0 0 0 0 0	# common exprs: b,c,o,c1,o1
+C0
+o2
+v0
+v1
+C1
+o2
+v0
+v1
+C2
+n0
+C3
+n0
+C4
+n0
+r
+1 1
+2 -1
+1 2
+1 3
+1 1
+b
+0 -1 1
+0 -1 1
+k1
+5
+J0 2
+0 0
+1 0
+J1 2
+0 0
+1 0
+J2 2
+0 1
+1 2
+J3 2
+0 2
+1 4
+J4 2
+0 -1
+1 -2
@@ -0,0 +1,27 @@
+g3 1 1 0	# problem fixed_vars
+ 3 1 0 0 0	# vars, constraints, objectives, ranges, eqns
+ 1 0	# nonlinear constraints, objectives
+ 0 0	# network constraints: nonlinear, linear
+ 2 0 0	# nonlinear vars in constraints, objectives, both
+ 0 0 0 1	# linear network variables; functions; arith, flags
+ 0 0 0 0 0	# discrete variables: binary, integer, nonlinear (b,c,o)
+ 3 0	# nonzeros in Jacobian, gradients
+ 0 0	# max name lengths: constraints, variables
+ 0 0 0 0 0	# common exprs: b,c,o,c1,o1
+C0
+o2
+v0
+v1
+r
+1 1
+b
+0 -1 1
+4 2
+0 -1 1
+k2
+1
+2
+J0 3
+0 0
+1 3
+2 1
@@ -0,0 +1,23 @@
+g3 1 1 0	# problem nl_fallback
+ 1 1 0 0 0	# vars, constraints, objectives, ranges, eqns
+ 1 0	# nonlinear constraints, objectives
+ 0 0	# network constraints: nonlinear, linear
+ 1 0 0	# nonlinear vars in constraints, objectives, both
+ 0 0 0 1	# linear network variables; functions; arith, flags
+ 0 0 0 0 0	# discrete variables: binary, integer, nonlinear (b,c,o)
+ 1 0	# nonzeros in Jacobian, gradients
+ 0 0	# max name lengths: constraints, variables
+ 0 1 0 0 0	# common exprs: b,c,o,c1,o1
+C0
+v1
+V1 0 0
+o5
+v0
+n2
+r
+1 1
+b
+0 -1 1
+k0
+J0 1
+0 0
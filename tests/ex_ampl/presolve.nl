@@ -0,0 +1,36 @@
+g3 1 1 0	# problem presolve
+ 3 3 0 0 1	# vars, constraints, objectives, ranges, eqns
+ 0 0	# nonlinear constraints, objectives
+ 0 0	# network constraints: nonlinear, linear
+ 0 0 0	# nonlinear vars in constraints, objectives, both
+ 0 0 0 1	# linear network variables; functions; arith, flags
+ 0 0 0 0 0	# discrete variables: binary, integer, nonlinear (b,c,o)
+ 6 0	# nonzeros in Jacobian, gradients
+ 0 0	# max name lengths: constraints, variables
+ 0 0 0 0 0	# common exprs: b,c,o,c1,o1
+C0
+n0
+C1
+n0
+C2
+n0
+r
+1 1
+4 1
+2 -3
+b
+0 -1 1
+0 -1 1
+3
+k2
+2
+4
+J0 3
+0 1
+1 2
+2 1
+J1 1
+2 1
+J2 2
+0 1
+1 2
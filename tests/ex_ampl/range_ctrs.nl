@@ -0,0 +1,42 @@
+g3 1 1 0	# problem range_ctrs
+ 3 3 0 3 0	# vars, constraints, objectives, ranges, eqns
+ 3 0	# nonlinear constraints, objectives
+ 0 0	# network constraints: nonlinear, linear
+ 3 0 0	# nonlinear vars in constraints, objectives, both
+ 0 0 0 1	# linear network variables; functions; arith, flags
+ 0 0 0 0 0	# discrete variables: binary, integer, nonlinear (b,c,o)
+ 6 0	# nonzeros in Jacobian, gradients
+ 0 0	# max name lengths: constraints, variables
+ 0 0 0 0 0	# common exprs: b,c,o,c1,o1
+C0
+o2
+v0
+v1
+C1
+o2
+v1
+v2
+C2
+o2
+v2
+v0
+r
+0 -0.5 0.5
+0 -0.5 0.5
+0 -0.5 0.5
+b
+0 -1 1
+0 -1 1
+0 -1 1
+k2
+2
+4
+J0 2
+0 0
+1 0
+J1 2
+1 0
+2 0
+J2 2
+0 0
+2 0